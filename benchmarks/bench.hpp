@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libyang-cpp/Context.hpp>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+/*
+ * A minimal harness for the bench_* executables. Each of them prints one JSON document to stdout:
+ *
+ * {"benchmark": "get-data", "results": [{"name": "...", "iterations": N, "min_ns": ..., "median_ns": ..., "p99_ns": ...,
+ *  "mean_ns": ..., <extra numeric fields>}, ...]}
+ */
+namespace bench {
+
+struct Stats {
+    std::size_t iterations;
+    std::chrono::nanoseconds min, median, p99, mean;
+};
+
+/** @short Runs @p fn once to warm up, and then @p iterations times while measuring each run */
+template <typename Fn>
+Stats measure(const std::size_t iterations, Fn&& fn)
+{
+    fn();
+    std::vector<std::chrono::nanoseconds> samples;
+    samples.reserve(iterations);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::steady_clock::now() - start);
+    }
+    std::sort(samples.begin(), samples.end());
+    std::chrono::nanoseconds total{0};
+    for (const auto& sample : samples) {
+        total += sample;
+    }
+    return {
+        .iterations = iterations,
+        .min = samples.front(),
+        .median = samples[samples.size() / 2],
+        .p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)],
+        .mean = total / static_cast<std::chrono::nanoseconds::rep>(iterations),
+    };
+}
+
+class Report {
+public:
+    explicit Report(std::string benchmark)
+        : m_benchmark(std::move(benchmark))
+    {
+    }
+
+    void add(const std::string& name, const Stats& stats, const std::vector<std::pair<std::string, double>>& extra = {})
+    {
+        auto entry = R"({"name": ")" + name + R"(", "iterations": )" + std::to_string(stats.iterations)
+            + R"(, "min_ns": )" + std::to_string(stats.min.count()) + R"(, "median_ns": )" + std::to_string(stats.median.count())
+            + R"(, "p99_ns": )" + std::to_string(stats.p99.count()) + R"(, "mean_ns": )" + std::to_string(stats.mean.count());
+        for (const auto& [key, value] : extra) {
+            entry += R"(, ")" + key + R"(": )" + std::to_string(value);
+        }
+        m_entries.push_back(entry + "}");
+        // Progress goes to stderr, so that stdout remains valid JSON
+        std::cerr << m_benchmark << ": " << name << ": median " << stats.median.count() << " ns\n";
+    }
+
+    ~Report()
+    {
+        std::cout << R"({"benchmark": ")" << m_benchmark << R"(", "results": [)";
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            std::cout << (i ? ",\n  " : "\n  ") << m_entries[i];
+        }
+        std::cout << "\n]}\n";
+    }
+
+private:
+    std::string m_benchmark;
+    std::vector<std::string> m_entries;
+};
+
+inline libyang::Context emptyContext()
+{
+    return libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+}
+
+/** @short A client session to the mock server, along with the socket which libnetconf2 does not close on its own */
+struct Client {
+    Client(mock_server::Server& server, std::optional<libyang::Context> ctx = std::nullopt)
+        : fd(server.connect())
+        , session(libnetconf::client::Session::connectFd(fd, fd, ctx ? *ctx : emptyContext()))
+    {
+    }
+
+    ~Client()
+    {
+        session.reset();
+        ::close(fd);
+    }
+
+    int fd;
+    std::unique_ptr<libnetconf::client::Session> session;
+};
+
+/** @short Large replies take longer than the default timeout of 20 seconds */
+inline libnetconf::client::CallOptions patient()
+{
+    return {.deadline = std::chrono::steady_clock::now() + std::chrono::minutes{10}};
+}
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "bench.hpp"
+
+int main()
+{
+    mock_server::Server server{TESTS_DIR "/modules", {}};
+    bench::Report report{"connect"};
+
+    // Every connect fetches and compiles all of the server's modules
+    report.add("fresh-context", bench::measure(20, [&server] {
+        bench::Client client{server};
+    }));
+
+    // Once the context has the modules, nothing is fetched, but the context still has to be checked against the YANG library
+    auto ctx = bench::emptyContext();
+    report.add("shared-context", bench::measure(200, [&server, &ctx] {
+        bench::Client client{server, ctx};
+    }));
+
+    // The modules are found on the local disk rather than fetched from the server
+    report.add("search-dir", bench::measure(20, [&server] {
+        bench::Client client{server, libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd)};
+    }));
+}
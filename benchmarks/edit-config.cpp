@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "bench.hpp"
+
+int main()
+{
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {.match = {"<edit-config"}, .reply = "<ok/>"},
+        {.match = {"<edit-data"}, .reply = "<ok/>"},
+    }};
+    bench::Client client{server};
+    bench::Report report{"edit-config"};
+
+    const std::string leaf = R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)";
+    report.add("edit-config", bench::measure(2000, [&client, &leaf] {
+        client.session->editConfig(libnetconf::Datastore::Running, libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::TestSet, libnetconf::EditErrorOpt::Rollback, leaf);
+    }));
+    report.add("edit-config-validated", bench::measure(2000, [&client, &leaf] {
+        client.session->editConfig(libnetconf::Datastore::Running, libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::TestSet, libnetconf::EditErrorOpt::Rollback, leaf, {.validateLocally = true});
+    }));
+
+    const auto interfaces = mock_server::syntheticInterfaces(1000);
+    report.add("edit-data-1000-interfaces", bench::measure(200, [&client, &interfaces] {
+        client.session->editData(libnetconf::NmdaDatastore::Running, interfaces);
+    }), {{"payload_bytes", interfaces.size()}});
+}
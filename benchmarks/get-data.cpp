@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <charconv>
+#include <cstring>
+#include "bench.hpp"
+
+/*
+ * Usage: bench_get-data [MAX_BYTES]
+ *
+ * Replies range from 1 kB up to MAX_BYTES, which defaults to 500 MB. Keep in mind that the largest reply needs several
+ * times its size in memory, on both sides.
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t maxBytes = 500'000'000;
+    if (argc > 1 && std::from_chars(argv[1], argv[1] + std::strlen(argv[1]), maxBytes).ec != std::errc{}) {
+        std::cerr << "Usage: " << argv[0] << " [MAX_BYTES]\n";
+        return 1;
+    }
+
+    const std::vector<std::size_t> sizes{1'000, 16'000, 256'000, 4'000'000, 64'000'000, 500'000'000};
+    std::vector<mock_server::Rule> rules;
+    std::vector<std::string> filters;
+    for (auto size : sizes) {
+        if (size <= maxBytes) {
+            // The filter is only used to pick the reply
+            filters.push_back("/ietf-interfaces:interfaces[" + std::to_string(size) + "]");
+            rules.push_back({
+                .match = {"<get-data", filters.back()},
+                .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda">)" + mock_server::syntheticInterfaces(mock_server::syntheticInterfacesFor(size)) + "</data>",
+            });
+        }
+    }
+
+    mock_server::Server server{TESTS_DIR "/modules", rules};
+    bench::Client client{server};
+    bench::Report report{"get-data"};
+
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+        const auto& filter = filters[i];
+        auto bytes = rules[i].reply.size();
+        auto iterations = std::clamp<std::size_t>(256'000'000 / bytes, 3, 1000);
+        auto stats = bench::measure(iterations, [&client, &filter] {
+            client.session->getData(libnetconf::NmdaDatastore::Operational, filter, bench::patient());
+        });
+        report.add(std::to_string(bytes) + " bytes", stats, {
+            {"reply_bytes", bytes},
+            {"bytes_per_second", bytes / std::chrono::duration<double>(stats.median).count()},
+        });
+    }
+}
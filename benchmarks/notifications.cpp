@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "bench.hpp"
+
+int main()
+{
+    // The session has no subscription of its own; notifications which arrive while it waits for a reply are
+    // received, parsed and set aside by libnetconf2, which is the cost measured here.
+    constexpr unsigned count = 10'000;
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {
+            .match = {"<get-data"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"/>)",
+            .notifications = count,
+            .notification = R"(<netconf-config-change xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-notifications"><datastore>running</datastore></netconf-config-change>)",
+        },
+    }};
+    bench::Client client{server};
+    bench::Report report{"notifications"};
+
+    auto stats = bench::measure(10, [&client] {
+        client.session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, bench::patient());
+    });
+    report.add(std::to_string(count) + " notifications", stats, {
+        {"notifications_per_second", count / std::chrono::duration<double>(stats.median).count()},
+    });
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include "bench.hpp"
+
+namespace {
+std::string errors(const unsigned count)
+{
+    std::string res;
+    for (unsigned i = 0; i < count; ++i) {
+        res += R"(<rpc-error>
+  <error-type>application</error-type>
+  <error-tag>invalid-value</error-tag>
+  <error-severity>error</error-severity>
+  <error-path xmlns:if="urn:ietf:params:xml:ns:yang:ietf-interfaces">/if:interfaces/if:interface[if:name='eth)" + std::to_string(i) + R"(']/if:description</error-path>
+  <error-message xml:lang="en">Invalid description</error-message>
+</rpc-error>
+)";
+    }
+    return res;
+}
+}
+
+int main()
+{
+    const std::vector<unsigned> counts{1, 10, 100};
+    std::vector<mock_server::Rule> rules;
+    for (auto count : counts) {
+        rules.push_back({.match = {"<get-data", "[" + std::to_string(count) + "]"}, .reply = errors(count)});
+    }
+    mock_server::Server server{TESTS_DIR "/modules", rules};
+    bench::Client client{server};
+    bench::Report report{"rpc-error"};
+
+    for (auto count : counts) {
+        auto filter = "/ietf-interfaces:interfaces[" + std::to_string(count) + "]";
+        report.add(std::to_string(count) + " errors", bench::measure(1000, [&client, &filter] {
+            try {
+                client.session->getData(libnetconf::NmdaDatastore::Running, filter);
+            } catch (const libnetconf::client::ReportedError&) {
+            }
+        }), {{"errors", count}});
+    }
+}
@@ -0,0 +1,65 @@
+#
+# Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+# libnetconf2_cpp_generate_bindings(<target> HEADER <name.hpp> MODULES <module[@revision]>...
+#                                   [NAMESPACE <ns>] [SEARCH_DIRS <dir>...])
+#
+# Generates C++ types for the data nodes of the given YANG modules into a header which <target> can include as
+# <name.hpp>. Each module gets its own namespace within <ns>, and a `Root` struct whose `materialize()` fills the whole
+# structure from a data tree, such as the one returned by Session::getData().
+#
+# The generator is LIBNETCONF2_CPP_BINDGEN. Within this project, that's the netconf2-cpp-bindgen target. Projects which
+# use an installed libnetconf2-cpp include() this file from the `cmakedir` of its pkg-config file, and the installed
+# netconf2-cpp-bindgen is then looked up in the PATH, unless LIBNETCONF2_CPP_BINDGEN is an absolute path:
+#
+#   pkg_check_modules(LIBNETCONF2_CPP REQUIRED IMPORTED_TARGET libnetconf2-cpp)
+#   pkg_get_variable(LIBNETCONF2_CPP_CMAKEDIR libnetconf2-cpp cmakedir)
+#   include(${LIBNETCONF2_CPP_CMAKEDIR}/GenerateBindings.cmake)
+set(LIBNETCONF2_CPP_BINDGEN netconf2-cpp-bindgen CACHE STRING "The netconf2-cpp-bindgen executable, or its target")
+
+function(libnetconf2_cpp_generate_bindings target)
+    cmake_parse_arguments(BINDINGS "" "HEADER;NAMESPACE" "MODULES;SEARCH_DIRS" ${ARGN})
+    if(NOT BINDINGS_HEADER OR NOT BINDINGS_MODULES)
+        message(FATAL_ERROR "libnetconf2_cpp_generate_bindings: HEADER and MODULES are required")
+    endif()
+    if(NOT BINDINGS_NAMESPACE)
+        set(BINDINGS_NAMESPACE bindings)
+    endif()
+
+    set(output_dir "${CMAKE_CURRENT_BINARY_DIR}/${target}-bindings")
+    set(output "${output_dir}/${BINDINGS_HEADER}")
+    set(args --output "${output}" --namespace "${BINDINGS_NAMESPACE}")
+    set(depends)
+    foreach(dir ${BINDINGS_SEARCH_DIRS})
+        list(APPEND args --search-dir "${dir}")
+        foreach(module ${BINDINGS_MODULES})
+            string(REGEX REPLACE "@.*" "" module_name "${module}")
+            file(GLOB module_files "${dir}/${module_name}.yang" "${dir}/${module_name}@*.yang")
+            list(APPEND depends ${module_files})
+        endforeach()
+    endforeach()
+
+    if(TARGET ${LIBNETCONF2_CPP_BINDGEN})
+        # Rebuilding the generator regenerates the bindings
+        set(bindgen ${LIBNETCONF2_CPP_BINDGEN})
+    elseif(IS_ABSOLUTE ${LIBNETCONF2_CPP_BINDGEN})
+        set(bindgen ${LIBNETCONF2_CPP_BINDGEN})
+    else()
+        find_program(LIBNETCONF2_CPP_BINDGEN_EXECUTABLE ${LIBNETCONF2_CPP_BINDGEN} REQUIRED)
+        set(bindgen ${LIBNETCONF2_CPP_BINDGEN_EXECUTABLE})
+    endif()
+
+    add_custom_command(
+        OUTPUT "${output}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${output_dir}"
+        COMMAND ${bindgen} ${args} ${BINDINGS_MODULES}
+        DEPENDS ${bindgen} ${depends}
+        COMMENT "Generating YANG bindings ${BINDINGS_HEADER}"
+        VERBATIM
+        )
+    target_sources(${target} PRIVATE "${output}")
+    target_include_directories(${target} PRIVATE "${output_dir}")
+endfunction()
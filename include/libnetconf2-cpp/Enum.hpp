@@ -52,4 +52,12 @@ enum class EditErrorOpt {
     Continue,
     Rollback
 };
+
+enum class SshKnownHosts {
+    Ask,
+    Strict,
+    AcceptNew,
+    Accept,
+    Skip
+};
 }
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstdint>
+#include <libyang-cpp/DataNode.hpp>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+/** @short Support code for the bindings generated by netconf2-cpp-bindgen, see libnetconf2_cpp_generate_bindings() in CMake */
+namespace libnetconf::bindings {
+
+/** @short The name of the schema node of @p node, without allocating; empty for opaque nodes */
+std::string_view schemaName(const libyang::DataNode& node);
+/** @short The name of the module of @p node, without allocating; empty for opaque nodes */
+std::string_view moduleName(const libyang::DataNode& node);
+
+/** @short The value of a leaf or a leaf-list instance as stored by libyang, i.e., without any string parsing */
+template <typename T>
+T leafValue(const libyang::DataNode& node)
+{
+    if constexpr (std::is_same_v<T, std::string>) {
+        return node.asTerm().valueStr();
+    } else if constexpr (std::is_same_v<T, double>) {
+        const auto dec = std::get<libyang::Decimal64>(node.asTerm().value());
+        double divisor = 1;
+        for (auto i = 0; i < dec.digits; ++i) {
+            divisor *= 10;
+        }
+        return static_cast<double>(dec.number) / divisor;
+    } else {
+        return std::get<T>(node.asTerm().value());
+    }
+}
+}
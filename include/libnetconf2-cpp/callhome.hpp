@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <mutex>
+#include <thread>
+
+namespace libnetconf::client {
+
+struct CallHomeOptions {
+    std::string address = "::";
+    uint16_t port = 4334;
+    SshOptions ssh;
+    /** How many threads perform the SSH and NETCONF handshakes */
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    /** Connections which were accepted, but have not been picked up by a worker yet. Further ones are dropped. */
+    size_t maxPending = 1024;
+    /** A local directory with YANG modules which is consulted before asking the device via get-schema */
+    std::optional<std::filesystem::path> schemaSearchPath;
+    /** A context shared by all sessions, see CallHomeListener */
+    std::optional<libyang::Context> ctx;
+};
+
+/** @short Accepts NETCONF Call Home (RFC 8071) connections over SSH
+
+A single thread accepts the TCP connections, and a pool of workers performs the SSH handshake, the authentication and
+the NETCONF session setup in parallel. Established sessions are queued for the application which retrieves them via
+accept().
+
+When a shared context is configured, it is used as-is. libnetconf2 does not load any modules into it, so sessions are
+set up in parallel, and the established ones can parse their data in the context while other devices connect. It
+therefore has to contain ietf-netconf and every module that the devices' data use, with the right features enabled;
+whatever is missing is simply not available in the sessions.
+*/
+class CallHomeListener {
+public:
+    CallHomeListener(const CallHomeOptions& options);
+    ~CallHomeListener();
+    CallHomeListener(const CallHomeListener&) = delete;
+    CallHomeListener& operator=(const CallHomeListener&) = delete;
+
+    uint16_t port() const;
+    std::unique_ptr<Session> accept(const std::chrono::milliseconds timeout);
+
+private:
+    void acceptLoop(std::stop_token stop);
+    void workerLoop(std::stop_token stop);
+
+    CallHomeOptions m_options;
+    int m_listenFd;
+    int m_wakeupFd;
+
+    std::mutex m_pendingMtx;
+    std::condition_variable_any m_pendingCv;
+    std::deque<std::pair<int, std::string>> m_pending;
+
+    std::mutex m_establishedMtx;
+    std::condition_variable m_establishedCv;
+    std::deque<std::unique_ptr<Session>> m_established;
+    std::exception_ptr m_acceptError;
+
+    std::vector<std::jthread> m_workers;
+    std::jthread m_acceptor;
+};
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <libnetconf2-cpp/compiled-path.hpp>
+#include <libyang-cpp/Enum.hpp>
+#include <string>
+#include <variant>
+#include <vector>
+
+struct lysc_node;
+
+namespace libnetconf::client {
+
+/** @short Values of one leaf across all entries of a list */
+struct Column {
+    std::string path;
+    /** The base type of the leaf, e.g., Uint32 for a yang:counter32 */
+    libyang::LeafBaseType type;
+    std::variant<std::vector<uint64_t>, std::vector<int64_t>, std::vector<double>> values;
+    /** 1 if the leaf was present in the corresponding list entry, 0 if it was missing (and the value is 0) */
+    std::vector<uint8_t> present;
+};
+
+/** @short One row per list entry, one Column per leaf */
+struct Columns {
+    /** The key values of each list entry, separated by a comma */
+    std::vector<std::string> keys;
+    std::vector<Column> columns;
+};
+
+/** @short Extracts numeric leaves of all entries of a list into contiguous arrays
+
+The list is given by its data path without predicates, e.g., "/ietf-interfaces:interfaces/interface", and the leaves by
+paths relative to the list entry, e.g., "statistics/in-octets". Unsigned integers end up in a uint64_t column, signed
+integers in an int64_t column, and decimal64 values in a double column. Other types are not supported.
+
+Just like with CompiledPath, all paths are resolved when the extractor is created, so an extraction is a single pass
+over the list with a few hash lookups per entry.
+*/
+class ColumnExtractor {
+public:
+    ColumnExtractor(const libyang::Context& ctx, const std::string& listPath, const std::vector<std::string>& leafPaths);
+
+    Columns extract(const libyang::DataNode& tree) const;
+
+private:
+    enum class Kind : uint8_t {
+        Unsigned,
+        Signed,
+        Decimal,
+    };
+    struct Leaf {
+        std::string path;
+        std::vector<const lysc_node*> chain;
+        Kind kind;
+        libyang::LeafBaseType type;
+    };
+    CompiledPath m_list;
+    std::vector<Leaf> m_leaves;
+};
+
+std::vector<double> counterRates(const Columns& previous, const Columns& current, const size_t column, const std::chrono::duration<double> interval);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/DataNode.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct lyd_node;
+struct lysc_node;
+
+namespace libnetconf::client {
+
+/** @short A data path which is resolved against the schema once, and then looked up in many data trees
+
+The path must not contain any predicates, e.g., "/ietf-interfaces:interfaces-state/interface/statistics" is not
+accepted because it passes through a list, but "/ietf-system:system-state/clock/current-datetime" is. A list or a
+leaf-list is only allowed as the last node of the path; find() returns its first instance, and findAll() returns all of
+them. Each step of a lookup is a hash lookup among the children of the previous node, with no string parsing or
+schema resolution.
+
+The context must outlive this object, and it must not be changed while this object is in use. Loading or implementing
+a module, or changing a feature, recompiles the context, and the path has to be resolved again; the context's
+ly_ctx_get_change_count() tells when that has happened.
+*/
+class CompiledPath {
+public:
+    CompiledPath(const libyang::Context& ctx, const std::string& path, const libyang::InputOutputNodes inputOutputNodes = libyang::InputOutputNodes::Input);
+
+    std::optional<libyang::DataNode> find(const libyang::DataNode& tree) const;
+    std::vector<libyang::DataNode> findAll(const libyang::DataNode& tree) const;
+    lyd_node* findRaw(const lyd_node* tree) const;
+    const std::string& path() const;
+
+private:
+    libyang::Context m_ctx;
+    std::string m_path;
+    std::vector<const lysc_node*> m_chain;
+};
+}
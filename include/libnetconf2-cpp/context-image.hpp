@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <libyang-cpp/Context.hpp>
+#include <optional>
+
+namespace libnetconf::client {
+
+bool contextImagesSupported();
+uintptr_t contextImageAddress(const std::filesystem::path& path);
+void printContextImage(const libyang::Context& ctx, const std::filesystem::path& path, const std::optional<uintptr_t>& address = std::nullopt);
+libyang::Context mapContextImage(const std::filesystem::path& path);
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <libyang-cpp/DataNode.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace libnetconf::client {
+
+/** @short A single difference between two data trees */
+struct Change {
+    enum class Type {
+        Created,
+        Deleted,
+        Modified,
+    };
+    Type type;
+    /** The data path, including list predicates */
+    std::string path;
+    /** For leaves, and leaf-list instances which were deleted */
+    std::optional<std::string> oldValue;
+    /** For leaves, and leaf-list instances which were created */
+    std::optional<std::string> newValue;
+
+    bool operator==(const Change&) const = default;
+};
+
+std::vector<Change> diff(const std::optional<libyang::DataNode>& oldTree, const std::optional<libyang::DataNode>& newTree, const std::optional<std::string>& subtree = std::nullopt);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace libnetconf::client {
+
+/** @short Counters of client sessions, rendered in the Prometheus text exposition format
+
+Once a registry is installed via setMetrics(), all sessions which are created from then on update it, until they are
+closed. All counters are plain relaxed atomics, so sessions never contend on a lock for that.
+
+The amount of received data is only known for sessions whose traffic goes through a relay, i.e., those from
+Session::connectFdRecording() and those with ConnectProfiling::Detailed. It is reported whenever an RPC finishes, and
+when the session is closed.
+*/
+class Metrics {
+public:
+    enum class Operation {
+        Get,
+        GetConfig,
+        GetData,
+        EditConfig,
+        EditData,
+        CopyConfig,
+        Lock,
+        Unlock,
+        Validate,
+        Commit,
+        Discard,
+        CancelCommit,
+        Generic,
+        Other,
+    };
+
+    enum class Outcome {
+        Ok,
+        RpcError,
+        Failed,
+    };
+
+    static constexpr std::array<double, 13> latencyBuckets{0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 10};
+
+    void sessionOpened();
+    void sessionClosed();
+    void connectFinished(const std::chrono::nanoseconds duration, const bool success);
+    void rpcFinished(const Operation op, const Outcome outcome, const std::chrono::nanoseconds duration);
+    void rpcErrorReported(std::string_view tag);
+    void notificationReceived();
+    void bytesReceived(const uint64_t bytes);
+
+    std::string render() const;
+    void renderTo(const int fd) const;
+
+private:
+    static constexpr auto operationCount = static_cast<size_t>(Operation::Other) + 1;
+    static constexpr std::array<std::string_view, 20> errorTags{
+        "in-use", "invalid-value", "too-big", "missing-attribute", "bad-attribute", "unknown-attribute", "missing-element",
+        "bad-element", "unknown-element", "unknown-namespace", "access-denied", "lock-denied", "resource-denied",
+        "rollback-failed", "data-exists", "data-missing", "operation-not-supported", "operation-failed",
+        "partial-operation", "malformed-message"};
+
+    std::atomic<uint64_t> m_sessionsOpened{0};
+    std::atomic<uint64_t> m_sessionsClosed{0};
+    std::atomic<uint64_t> m_connects{0};
+    std::atomic<uint64_t> m_connectFailures{0};
+    std::atomic<uint64_t> m_connectNanoseconds{0};
+    std::array<std::array<std::atomic<uint64_t>, 3>, operationCount> m_rpcs{};
+    std::array<std::atomic<uint64_t>, latencyBuckets.size() + 1> m_latency{};
+    std::atomic<uint64_t> m_latencyNanoseconds{0};
+    std::array<std::atomic<uint64_t>, errorTags.size() + 1> m_errorTags{};
+    std::atomic<uint64_t> m_notifications{0};
+    std::atomic<uint64_t> m_receivedBytes{0};
+};
+
+void setMetrics(Metrics* metrics);
+}
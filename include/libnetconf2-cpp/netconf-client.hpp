@@ -1,11 +1,17 @@
 #pragma once
 
+#include <chrono>
+#include <filesystem>
 #include <functional>
 #include <libyang-cpp/Context.hpp>
+#include <libnetconf2-cpp/compiled-path.hpp>
 #include <libnetconf2-cpp/Enum.hpp>
 #include <memory>
 #include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
+#include <utility>
 #include <vector>
 
 struct nc_session;
@@ -16,12 +22,98 @@ class DataNode;
 }
 
 namespace libnetconf {
+namespace impl {
+struct CallState;
+}
+namespace server {
+class Dispatcher;
+}
+
 namespace client {
 
+/** @short One <rpc-error> as reported by the server */
+struct ErrorInfo {
+    std::string type;
+    std::string tag;
+    std::string severity;
+    std::optional<std::string> appTag;
+    std::optional<std::string> path;
+    std::optional<std::string> message;
+};
+
 class ReportedError : public std::runtime_error {
 public:
-    ReportedError(const std::string& what);
+    ReportedError(const std::string& what, std::vector<ErrorInfo> errors = {});
     ~ReportedError() override;
+    const std::vector<ErrorInfo>& errors() const;
+
+private:
+    std::vector<ErrorInfo> m_errors;
+};
+
+/** @short The operation was abandoned because its CallOptions::stopToken was triggered */
+class Cancelled : public std::runtime_error {
+public:
+    Cancelled(const std::string& what);
+    ~Cancelled() override;
+};
+
+/** @short The operation did not finish before its deadline */
+class TimedOut : public std::runtime_error {
+public:
+    TimedOut(const std::string& what);
+    ~TimedOut() override;
+};
+
+/** @short An edit was rejected by the local schema check, see CallOptions::validateLocally
+
+Nothing was sent to the server. The errors use the same error-tags as the server would have used.
+*/
+class LocalValidationError : public ReportedError {
+public:
+    LocalValidationError(const std::string& what, std::vector<ErrorInfo> errors);
+    ~LocalValidationError() override;
+};
+
+/** @short How to retry operations which fail because of a transient condition on the server
+
+An operation is retried when all of its <rpc-error>s carry one of the `retryOn` error tags. The pause between attempts
+starts at `initialBackoff` and grows by `multiplier` up to `maxBackoff`; each pause is randomly shortened by up to
+`jitter` (a fraction of the pause) so that competing clients do not retry in lockstep. Retrying stops after
+`maxAttempts` attempts, or when the next attempt would start past the deadline. That's either the CallOptions
+deadline, or `overallTimeout` after the first attempt, whichever comes first.
+*/
+struct RetryPolicy {
+    unsigned maxAttempts = 5;
+    std::chrono::milliseconds initialBackoff{100};
+    std::chrono::milliseconds maxBackoff{5000};
+    double multiplier = 2.0;
+    double jitter = 0.5;
+    std::optional<std::chrono::milliseconds> overallTimeout;
+    std::vector<std::string> retryOn{"lock-denied", "in-use", "resource-denied"};
+};
+
+/** @short Per-call settings of Session's operations
+
+Without a deadline, each operation waits for up to 20 seconds for its reply. When the operation is cancelled or its
+deadline passes after the RPC has been sent, the call returns promptly, but the server still executes the RPC and
+replies eventually. The session remembers such abandoned calls, and the next call reads and discards their late replies
+before waiting for its own, within its own deadline. The session therefore remains usable as long as the server
+answers at all, but a call which follows an abandoned one might have to wait for the abandoned RPC to finish first.
+*/
+struct CallOptions {
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::stop_token stopToken;
+    /** Operations are not retried unless they opt in by providing a policy */
+    std::optional<RetryPolicy> retry;
+    /** @short Check the payload of edit-config, edit-data and copy-config against the session's schema before sending it
+
+    Edits are usually partial, so they are only checked for unknown nodes, values of the wrong type and state data.
+    A leaf which is being deleted or removed does not need a valid value. The payload of copy-config replaces the whole
+    datastore, so it is fully validated, including mandatory nodes, must and when conditions, and leafrefs. Violations
+    are reported as a LocalValidationError.
+    */
+    bool validateLocally = false;
 };
 
 using LogCb = std::function<void(const nc_session*, LogLevel, const char*)>;
@@ -29,30 +121,211 @@ using LogCb = std::function<void(const nc_session*, LogLevel, const char*)>;
 void setLogLevel(LogLevel level);
 void setLogCallback(const LogCb& callback);
 
+/** @short Authentication and host verification settings for NETCONF-over-SSH */
+struct SshOptions {
+    std::string username;
+    /** Pairs of (public key, private key) file paths */
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> keyPairs;
+    std::optional<std::string> password;
+    std::optional<std::filesystem::path> knownHostsFile;
+    SshKnownHosts knownHosts = SshKnownHosts::Strict;
+};
+
+/** @short What happened while a Session was being established */
+struct ConnectProfile {
+    struct Module {
+        std::string name;
+        std::optional<std::string> revision;
+        bool implemented;
+    };
+    /** @short One <get-schema> which libnetconf2 has sent in order to fill the context */
+    struct Fetch {
+        std::string module;
+        std::optional<std::string> revision;
+        /** From sending the request until the whole reply has arrived */
+        std::chrono::microseconds duration;
+        /** The size of the reply on the wire */
+        uint64_t bytes;
+    };
+    /** @short Where the time of sessionSetup went
+
+    The phases which wait for the server are measured on the wire, the rest is the time spent in the client. The
+    modules are parsed and compiled by libyang in the course of a single call, and the parsing of one module triggers
+    the fetches of the modules that it imports, so the compilation of individual modules cannot be told apart.
+    */
+    struct Phases {
+        /** Until the transport is up and both hello messages have been exchanged */
+        std::chrono::microseconds hello;
+        /** Waiting for the list of the server's modules (the YANG library, or ietf-netconf-monitoring) */
+        std::chrono::microseconds moduleDiscovery;
+        /** Waiting for the modules themselves, i.e., the sum of all fetches */
+        std::chrono::microseconds moduleFetch;
+        /** Everything else: parsing and compiling the modules in libyang and processing the replies in libnetconf2 */
+        std::chrono::microseconds local;
+    };
+    /** @short The time spent in libnetconf2's connect routine
+
+    This covers the transport setup, the hello exchange, the retrieval of the list of modules, fetching all modules
+    which were not already present in the context, and compiling them. libnetconf2 does all of that in one call.
+    */
+    std::chrono::microseconds sessionSetup;
+    /** @short Modules which were added to the context during the connect, i.e., the ones which had to be fetched and compiled
+
+    The modules which libyang puts into each new context are not included.
+    */
+    std::vector<Module> loadedModules;
+    /** Only available with ConnectProfiling::Detailed */
+    std::optional<Phases> phases;
+    /** Only available with ConnectProfiling::Detailed, in the order in which they were sent */
+    std::vector<Fetch> fetches;
+    /** The bytes sent to and received from the server during the connect, only available with ConnectProfiling::Detailed */
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+};
+
+enum class ConnectProfiling {
+    /** The overall time and the list of loaded modules */
+    Summary,
+    /** @short Also the phases, the individual fetches of modules, and the amount of data
+
+    The traffic is relayed through a socket for the whole lifetime of the session, which costs an extra copy of all data
+    and two threads.
+    */
+    Detailed,
+};
+
+class TrafficRecorder;
+class Session;
+
+/** @short A change of the candidate datastore which is applied to the running datastore as a whole
+
+Edits are only collected until commit() is called, which then needs three round trips regardless of the number of
+edits: it locks the candidate, then it sends all edits along with a validate, and finally it sends commit, discard and
+unlock in one go. The lock has to be confirmed before any edits are sent, so that they never get mixed into a candidate
+which somebody else is working on, and the commit has to wait until the edits are known to have succeeded. When an edit
+or the validation fails, the candidate is discarded and unlocked, and the first error is thrown.
+
+When the commit times out or is cancelled while the edits are still being processed, the candidate is discarded and
+unlocked as well, once the server has answered the outstanding edits. Nothing is attempted when the session has broken.
+*/
+class Transaction {
+public:
+    Transaction& editConfig(const EditDefaultOp defaultOperation, const EditTestOpt testOption, const EditErrorOpt errorOption, const std::string& data);
+    void commit(const CallOptions& options = {});
+
+private:
+    friend class Session;
+    explicit Transaction(Session& session);
+
+    struct Edit {
+        EditDefaultOp defaultOperation;
+        EditTestOpt testOption;
+        EditErrorOpt errorOption;
+        std::string data;
+    };
+    Session& m_session;
+    std::vector<Edit> m_edits;
+};
+
+/** @short Iterates over the entries of a list on the server, fetching them in pages of a bounded size
+
+Each page is a separate get-data whose XPath filter selects a range of positions within the list, so neither the reply
+nor the time spent waiting for it grows with the size of the list. The list path must not contain any predicates, see
+CompiledPath. The pages are not retrieved atomically: when entries are added or removed while the iteration is in
+progress, some entries might be skipped or returned twice.
+*/
+class ListCursor {
+public:
+    std::optional<libyang::DataNode> next();
+
+private:
+    friend class Session;
+    ListCursor(Session& session, const NmdaDatastore datastore, const std::string& listPath, const unsigned pageSize, const CallOptions& options);
+
+    Session& m_session;
+    NmdaDatastore m_datastore;
+    CompiledPath m_path;
+    /** ly_ctx_get_change_count() of the context at the time m_path was resolved */
+    uint16_t m_changeCount;
+    unsigned m_pageSize;
+    CallOptions m_options;
+    std::vector<libyang::DataNode> m_page;
+    size_t m_index = 0;
+    uint64_t m_offset = 0;
+    bool m_lastPage = false;
+};
+
 class Session {
 public:
     Session(struct nc_session* session);
     ~Session();
-    static std::unique_ptr<Session> connectSocket(const std::string& path, std::optional<libyang::Context> ctx = std::nullopt);
-    static std::unique_ptr<Session> connectFd(const int source, const int sink, std::optional<libyang::Context> ctx = std::nullopt);
+    static std::unique_ptr<Session> connectSocket(const std::string& path, std::optional<libyang::Context> ctx = std::nullopt, const ConnectProfiling profiling = ConnectProfiling::Summary);
+    static std::unique_ptr<Session> connectFd(const int source, const int sink, std::optional<libyang::Context> ctx = std::nullopt, const ConnectProfiling profiling = ConnectProfiling::Summary);
+    static std::unique_ptr<Session> connectInProcess(server::Dispatcher& dispatcher, const std::string& username, std::optional<libyang::Context> ctx = std::nullopt);
+    static std::unique_ptr<Session> connectFdRecording(const int source, const int sink, const std::filesystem::path& capture, std::optional<libyang::Context> ctx = std::nullopt);
+    static std::unique_ptr<Session> connectSsh(const std::string& host, const uint16_t port, const SshOptions& options, std::optional<libyang::Context> ctx = std::nullopt);
+    std::unique_ptr<Session> connectSshChannel(std::optional<libyang::Context> ctx = std::nullopt);
     [[nodiscard]] std::vector<std::string> capabilities() const;
-    std::optional<libyang::DataNode> get(const std::optional<std::string>& filter = std::nullopt);
-    std::optional<libyang::DataNode> getData(const NmdaDatastore datastore, const std::optional<std::string>& filter = std::nullopt);
+    std::optional<libyang::DataNode> get(const std::optional<std::string>& filter = std::nullopt, const CallOptions& options = {});
+    std::optional<libyang::DataNode> getData(const NmdaDatastore datastore, const std::optional<std::string>& filter = std::nullopt, const CallOptions& options = {});
     void editConfig(const Datastore datastore,
                     const EditDefaultOp defaultOperation,
                     const EditTestOpt testOption,
                     const EditErrorOpt errorOption,
-                    const std::string& data);
-    void editData(const NmdaDatastore datastore, const std::string& data);
-    void copyConfigFromString(const Datastore target, const std::string& data);
-    std::optional<libyang::DataNode> rpc_or_action(const std::string& xmlData);
-    void copyConfig(const Datastore source, const Datastore destination);
-    void commit();
-    void discard();
+                    const std::string& data,
+                    const CallOptions& options = {});
+    void editConfigFromFile(const Datastore datastore,
+                            const EditDefaultOp defaultOperation,
+                            const EditTestOpt testOption,
+                            const EditErrorOpt errorOption,
+                            const std::filesystem::path& path,
+                            const CallOptions& options = {});
+    void editConfigFromFd(const Datastore datastore,
+                          const EditDefaultOp defaultOperation,
+                          const EditTestOpt testOption,
+                          const EditErrorOpt errorOption,
+                          const int fd,
+                          const CallOptions& options = {});
+    void editConfigFromMemory(const Datastore datastore,
+                              const EditDefaultOp defaultOperation,
+                              const EditTestOpt testOption,
+                              const EditErrorOpt errorOption,
+                              const std::span<const char> data,
+                              const CallOptions& options = {});
+    void editData(const NmdaDatastore datastore, const std::string& data, const CallOptions& options = {});
+    void copyConfigFromString(const Datastore target, const std::string& data, const CallOptions& options = {});
+    void copyConfigFromFile(const Datastore target, const std::filesystem::path& path, const CallOptions& options = {});
+    void copyConfigFromFd(const Datastore target, const int fd, const CallOptions& options = {});
+    void copyConfigFromMemory(const Datastore target, const std::span<const char> data, const CallOptions& options = {});
+    std::optional<libyang::DataNode> rpc_or_action(const std::string& xmlData, const CallOptions& options = {});
+    void copyConfig(const Datastore source, const Datastore destination, const CallOptions& options = {});
+    void commit(const CallOptions& options = {});
+    void confirmedCommit(const std::chrono::seconds timeout, const std::optional<std::string>& persist = std::nullopt, const CallOptions& options = {});
+    void confirmCommit(const std::optional<std::string>& persistId = std::nullopt, const CallOptions& options = {});
+    void cancelCommit(const std::optional<std::string>& persistId = std::nullopt, const CallOptions& options = {});
+    void discard(const CallOptions& options = {});
+    void lock(const Datastore datastore, const CallOptions& options = {});
+    void unlock(const Datastore datastore, const CallOptions& options = {});
+    void validate(const Datastore datastore, const CallOptions& options = {});
+    Transaction transaction();
+    ListCursor listCursor(const NmdaDatastore datastore, const std::string& listPath, const unsigned pageSize = 1000, const CallOptions& options = {});
 
     libyang::Context libyangContext();
+    const ConnectProfile& connectProfile() const;
 protected:
+    friend class Transaction;
     struct nc_session* m_session;
+    ConnectProfile m_connectProfile;
+    std::unique_ptr<TrafficRecorder> m_recorder;
+    std::optional<int> m_ownedFd;
+    std::unique_ptr<impl::CallState> m_callState;
+    struct CachedPath {
+        std::optional<CompiledPath> path;
+        /** ly_ctx_get_change_count() of the context at the time the path was resolved */
+        uint16_t changeCount = 0;
+    };
+    CachedPath m_getPath;
+    CachedPath m_getDataPath;
 };
 }
 }
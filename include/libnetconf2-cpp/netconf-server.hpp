@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/DataNode.hpp>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct nc_pollsession;
+struct nc_session;
+struct lyd_node;
+struct nc_server_reply;
+
+namespace libnetconf::server {
+
+/** @short Thrown from an RPC handler to send an <rpc-error> with an operation-failed error tag to the client */
+class RpcError : public std::runtime_error {
+public:
+    RpcError(const std::string& what);
+    ~RpcError() override;
+};
+
+struct SessionInfo {
+    uint32_t id;
+    std::string_view username;
+};
+
+/** @short An RPC handler
+
+It receives the RPC or action node. When there's some output, return the RPC/action node with the output nodes as its
+children, otherwise return std::nullopt and the client gets an <ok/>.
+*/
+using RpcHandler = std::function<std::optional<libyang::DataNode>(const libyang::DataNode& rpc, const SessionInfo& session)>;
+
+class Dispatcher;
+
+/** @short A server session which is served for as long as this handle exists
+
+Destroying the handle ends the session, unless the client has already closed it. The dispatcher then frees the session
+and closes its file descriptors. A handle must not outlive its dispatcher.
+*/
+class Session {
+public:
+    Session(Session&& other) noexcept;
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session& operator=(Session&&) = delete;
+    ~Session();
+
+    uint32_t id() const;
+
+private:
+    friend class Dispatcher;
+    Session(Dispatcher& dispatcher, const uint32_t id);
+
+    Dispatcher* m_dispatcher;
+    uint32_t m_id;
+};
+
+/** @short A group of RPC handlers which share a concurrency limit
+
+At most `concurrency` handlers of a lane run at once, and at most `queueLimit` further RPCs wait for a free slot.
+RPCs beyond that are rejected with a resource-denied error right away.
+*/
+struct Lane {
+    std::string name;
+    unsigned concurrency;
+    size_t queueLimit = 0;
+};
+
+/** @short A NETCONF server which dispatches RPCs of many sessions on a pool of worker threads
+
+All sessions share one libnetconf2 pollsession. Every worker polls it, so an RPC is handled by whichever worker is
+free. The sessions are owned by the dispatcher and freed as soon as they terminate.
+
+Handlers are assigned to lanes. libnetconf2 sends the reply from the thread which has polled the RPC, so a running or
+a waiting handler occupies a worker. The pool therefore has one worker for every running and waiting slot of every
+lane, which means that a lane which has reached its limits can never take workers away from other lanes. That's how
+slow bulk reads stay out of the way of quick control RPCs.
+*/
+class Dispatcher {
+public:
+    Dispatcher(libyang::Context ctx, const unsigned workers = std::max(1u, std::thread::hardware_concurrency()));
+    Dispatcher(libyang::Context ctx, const std::vector<Lane>& lanes);
+    ~Dispatcher();
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+
+    void registerHandler(const std::string& schemaPath, RpcHandler handler, const std::string& lane = defaultLane);
+
+    static constexpr auto defaultLane = "default";
+    void acceptFd(const int source, const int sink, const std::string& username);
+    void acceptOwnedFd(const int fd, const std::string& username);
+    [[nodiscard]] Session open(const int source, const int sink, const std::string& username);
+    size_t sessionCount() const;
+
+private:
+    struct LaneState {
+        unsigned concurrency;
+        size_t queueLimit;
+        std::mutex mtx;
+        std::condition_variable cv;
+        unsigned running = 0;
+        size_t waiting = 0;
+
+        bool acquire();
+        void release();
+    };
+    struct Handler {
+        RpcHandler handler;
+        LaneState* lane;
+    };
+
+    friend class Session;
+
+    uint32_t accept(const int source, const int sink, const std::string& username, const std::vector<int>& ownedFds);
+    void terminate(const uint32_t id);
+    void workerLoop(std::stop_token stop);
+    static nc_server_reply* dispatch(lyd_node* rpc, nc_session* session);
+
+    libyang::Context m_ctx;
+    nc_pollsession* m_ps;
+    std::map<std::string, LaneState, std::less<>> m_lanes;
+    mutable std::shared_mutex m_handlersMtx;
+    std::map<std::string, Handler, std::less<>> m_handlers;
+    std::mutex m_sessionsMtx;
+    std::condition_variable_any m_sessionsCv;
+    std::atomic<size_t> m_sessionCount;
+    std::mutex m_registryMtx;
+    std::map<const nc_session*, std::vector<int>> m_ownedFds;
+    std::map<uint32_t, nc_session*> m_liveSessions;
+    std::vector<std::jthread> m_workers;
+};
+}
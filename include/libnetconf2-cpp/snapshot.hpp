@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <filesystem>
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/DataNode.hpp>
+#include <optional>
+#include <stdexcept>
+
+namespace libnetconf::client {
+
+/** @short The snapshot was written against a different set of YANG modules than the one used for loading it */
+class SnapshotMismatch : public std::runtime_error {
+public:
+    SnapshotMismatch(const std::string& what);
+    ~SnapshotMismatch() override;
+};
+
+void writeSnapshot(const libyang::DataNode& tree, const std::filesystem::path& path);
+std::optional<libyang::DataNode> readSnapshot(const libyang::Context& ctx, const std::filesystem::path& path);
+}
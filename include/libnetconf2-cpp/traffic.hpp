@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libnetconf::client {
+
+/** @short Captures the raw NETCONF traffic of a session into a file
+
+The recorder sits between the transport and libnetconf2: it relays all bytes between the original pair of file
+descriptors and a socket which is handed to libnetconf2, and it appends each chunk of data to the capture along with
+its direction and a timestamp. Use Session::connectFdRecording() rather than constructing this directly.
+
+Without a capture file, the recorder just relays the data and counts it. Until takeMessages() is called, it also keeps
+the size and the time of arrival of each message, which is what a detailed ConnectProfile is built from.
+
+The capture format is a sequence of records {int64 nanoseconds since start, uint8 direction, uint32 length, data} in
+little-endian byte order, following an 8-byte magic.
+*/
+class TrafficRecorder {
+public:
+    /** @short A complete message which has passed through the relay */
+    struct Message {
+        std::chrono::steady_clock::time_point end;
+        /** The size on the wire, including the framing */
+        uint64_t bytes;
+        /** The content of a message from the client, without the framing; empty for the server's messages */
+        std::string content;
+    };
+    struct Messages {
+        std::vector<Message> toServer;
+        std::vector<Message> toClient;
+    };
+
+    TrafficRecorder(const int source, const int sink, const std::optional<std::filesystem::path>& capture);
+    ~TrafficRecorder();
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    /** @short The file descriptor which libnetconf2 should use for both reading and writing */
+    int clientFd() const;
+    uint64_t bytesToServer() const;
+    uint64_t bytesToClient() const;
+    Messages takeMessages();
+
+private:
+    void record(const uint8_t direction, const char* data, const size_t length);
+    void toServerLoop();
+    void toClientLoop();
+
+    int m_source;
+    int m_sink;
+    int m_clientFd;
+    int m_relayFd;
+    int m_stopFd;
+    std::chrono::steady_clock::time_point m_start;
+    std::mutex m_captureMtx;
+    std::ofstream m_capture;
+    std::atomic<uint64_t> m_bytesToServer{0};
+    std::atomic<uint64_t> m_bytesToClient{0};
+    std::atomic<bool> m_collecting{true};
+    std::mutex m_messagesMtx;
+    Messages m_messages;
+    std::jthread m_toServer;
+    std::jthread m_toClient;
+};
+
+enum class ReplaySpeed {
+    Original, ///< Preserve the server's think time and the gaps between the chunks of its replies
+    Maximum, ///< Send each reply as soon as the client has sent the request which preceded it in the capture
+};
+
+/** @short Plays back the server side of a capture made by TrafficRecorder
+
+The replayer does not interpret the requests. It only counts the messages sent by the client, and sends the data which
+followed the same number of client messages in the capture. The chunked framing is parsed, so a message boundary is
+never confused with payload bytes. libnetconf2 assigns message-ids sequentially from the start of each session, so a
+client which performs the same sequence of operations gets replies that match its requests.
+*/
+class TrafficReplayer {
+public:
+    TrafficReplayer(const std::filesystem::path& capture, const ReplaySpeed speed);
+
+    void serve(const int source, const int sink) const;
+
+private:
+    struct Chunk {
+        /** How many complete messages the client must have sent before this chunk goes out */
+        size_t afterMessages;
+        /** The pause between the latest preceding event of the capture and this chunk */
+        std::chrono::nanoseconds delay;
+        std::string data;
+    };
+    std::vector<Chunk> m_chunks;
+    ReplaySpeed m_speed;
+};
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace libnetconf::utils {
+/** @short A read-only, NUL-terminated memory mapping of a regular file
+
+libnetconf2 wants its payloads as C strings. A plain mmap() of a file is not NUL-terminated when the file size happens
+to be a multiple of the page size, so this reserves one extra anonymous (and therefore zero-filled) byte past the end
+and maps the file over the beginning of that reservation. The page cache is used directly, no copy is made.
+*/
+class MappedFile {
+public:
+    explicit MappedFile(const int fd)
+    {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            throw std::system_error{errno, std::system_category(), "fstat"};
+        }
+        if (!S_ISREG(st.st_mode)) {
+            throw std::invalid_argument{"MappedFile: not a regular file"};
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        m_mappedSize = m_size + 1;
+
+        auto reserved = ::mmap(nullptr, m_mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) {
+            throw std::system_error{errno, std::system_category(), "mmap"};
+        }
+        m_data = static_cast<char*>(reserved);
+
+        if (m_size && ::mmap(reserved, m_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            auto err = errno;
+            ::munmap(reserved, m_mappedSize);
+            throw std::system_error{err, std::system_category(), "mmap"};
+        }
+        ::madvise(reserved, m_mappedSize, MADV_SEQUENTIAL);
+    }
+
+    ~MappedFile()
+    {
+        ::munmap(m_data, m_mappedSize);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    const char* c_str() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    char* m_data;
+    size_t m_size;
+    size_t m_mappedSize;
+};
+}
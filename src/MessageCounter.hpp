@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace libnetconf::utils {
+/** @short Counts complete NETCONF messages in one direction of a byte stream, regardless of how it is split
+
+Each message is framed on its own. A message which starts with "\n#" uses the chunked framing of RFC 6242, section
+4.2; the chunk headers are parsed and the chunk data is skipped without looking at it, so the payload can contain any
+bytes including the framing markers. Everything else is a base:1.0 message (such as the hello) which ends at the first
+"]]>]]>"; a well-formed XML document cannot contain that sequence. A malformed chunk header makes the counter look for
+the start of the next message.
+
+Optionally, a callback is invoked for each complete message with its size on the wire, including the framing and any
+whitespace which preceded it. It can also get the content of the message without the framing.
+*/
+class MessageCounter {
+public:
+    using Callback = std::function<void(const std::string& content, const uint64_t bytes)>;
+
+    void onMessage(const Callback& callback, const bool withContent)
+    {
+        m_callback = callback;
+        m_withContent = withContent;
+    }
+
+    void feed(const char* data, const size_t length)
+    {
+        const auto end = data + length;
+        m_bytes += length;
+        while (data != end) {
+            if (m_state == State::ChunkData) {
+                auto skip = static_cast<size_t>(std::min<uint64_t>(m_chunkLeft, end - data));
+                if (m_withContent) {
+                    m_content.append(data, skip);
+                }
+                data += skip;
+                m_chunkLeft -= skip;
+                if (!m_chunkLeft) {
+                    m_state = State::ChunkEndLF;
+                }
+                continue;
+            }
+            // The bytes which have not been consumed yet belong to the next message
+            m_pending = end - data - 1;
+            step(*data++);
+        }
+        m_pending = 0;
+    }
+
+    size_t count() const
+    {
+        return m_count;
+    }
+
+private:
+    enum class State {
+        Idle, ///< Between messages
+        IdleLF, ///< A '\n' between messages, either whitespace or the start of a chunk header
+        EndOfMessage, ///< Inside a base:1.0 message
+        ChunkHash, ///< Right after "\n#", expecting a chunk size or the second '#' of the end-of-chunks marker
+        ChunkSize,
+        ChunkData,
+        ChunkEndLF, ///< After the chunk data, expecting the "\n#" of the next header
+        ChunkEndHash,
+        EndOfChunksLF, ///< After "\n##", expecting the final '\n'
+    };
+
+    static bool isDigit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    void messageDone()
+    {
+        ++m_count;
+        m_state = State::Idle;
+        if (m_callback) {
+            m_callback(m_content, m_bytes - m_pending);
+        }
+        m_bytes = m_pending;
+        m_content.clear();
+    }
+
+    void step(const char c)
+    {
+        switch (m_state) {
+        case State::Idle:
+            if (c == '\n') {
+                m_state = State::IdleLF;
+            } else if (c != ' ' && c != '\t' && c != '\r') {
+                m_state = State::EndOfMessage;
+                m_eomMatched = 0;
+                step(c);
+            }
+            break;
+        case State::IdleLF:
+            if (c == '#') {
+                m_state = State::ChunkHash;
+            } else if (c != '\n') {
+                m_state = State::Idle;
+                step(c);
+            }
+            break;
+        case State::EndOfMessage:
+            if (m_withContent) {
+                m_content.push_back(c);
+            }
+            matchEndOfMessage(c);
+            break;
+        case State::ChunkHash:
+            if (c == '#') {
+                m_state = State::EndOfChunksLF;
+            } else if (isDigit(c) && c != '0') {
+                m_chunkLeft = c - '0';
+                m_state = State::ChunkSize;
+            } else {
+                m_state = State::Idle;
+            }
+            break;
+        case State::ChunkSize:
+            if (isDigit(c) && m_chunkLeft <= maxChunkSize / 10) {
+                m_chunkLeft = m_chunkLeft * 10 + (c - '0');
+            } else if (c == '\n' && m_chunkLeft <= maxChunkSize) {
+                m_state = State::ChunkData;
+            } else {
+                m_state = State::Idle;
+            }
+            break;
+        case State::ChunkData:
+            // feed() skips the chunk data in bulk
+            break;
+        case State::ChunkEndLF:
+            m_state = c == '\n' ? State::ChunkEndHash : State::Idle;
+            break;
+        case State::ChunkEndHash:
+            m_state = c == '#' ? State::ChunkHash : State::Idle;
+            break;
+        case State::EndOfChunksLF:
+            if (c == '\n') {
+                messageDone();
+            } else {
+                m_state = State::Idle;
+            }
+            break;
+        }
+    }
+
+    void matchEndOfMessage(const char c)
+    {
+        // Knuth-Morris-Pratt, the marker overlaps with itself
+        static constexpr std::array<char, 6> marker{']', ']', '>', ']', ']', '>'};
+        static constexpr std::array<uint8_t, 6> fallback{0, 1, 0, 1, 2, 3};
+        while (m_eomMatched && c != marker[m_eomMatched]) {
+            m_eomMatched = fallback[m_eomMatched - 1];
+        }
+        if (c == marker[m_eomMatched]) {
+            ++m_eomMatched;
+        }
+        if (m_eomMatched == marker.size()) {
+            if (m_withContent) {
+                m_content.resize(m_content.size() - marker.size());
+            }
+            messageDone();
+        }
+    }
+
+    /** RFC 6242 caps chunk-size at 4294967295 */
+    static constexpr uint64_t maxChunkSize = 4294967295;
+
+    State m_state = State::Idle;
+    uint64_t m_chunkLeft = 0;
+    size_t m_eomMatched = 0;
+    size_t m_count = 0;
+    Callback m_callback;
+    bool m_withContent = false;
+    std::string m_content;
+    uint64_t m_bytes = 0;
+    uint64_t m_pending = 0;
+};
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libnetconf2-cpp/bindings.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+
+namespace libnetconf::bindings {
+
+std::string_view schemaName(const libyang::DataNode& node)
+{
+    auto schema = libyang::getRawNode(node)->schema;
+    return schema ? schema->name : std::string_view{};
+}
+
+std::string_view moduleName(const libyang::DataNode& node)
+{
+    auto schema = libyang::getRawNode(node)->schema;
+    return schema ? schema->module->name : std::string_view{};
+}
+}
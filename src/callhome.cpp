@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <array>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <libnetconf2-cpp/callhome.hpp>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include "ClientInit.hpp"
+#include "UniqueResource.hpp"
+#include "ssh.hpp"
+#if defined(NC_ENABLED_SSH_TLS) && defined(HAVE_LIBSSH)
+#include <libssh/libssh.h>
+#endif
+
+namespace libnetconf::client {
+
+namespace {
+int listenOn(const std::string& address, const uint16_t port)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE | AI_NUMERICHOST | AI_NUMERICSERV;
+    addrinfo* res;
+    if (auto err = ::getaddrinfo(address.c_str(), std::to_string(port).c_str(), &hints, &res)) {
+        throw std::runtime_error{"Cannot resolve " + address + ": " + ::gai_strerror(err)};
+    }
+    auto freeRes = make_unique_resource([] {}, [res] { ::freeaddrinfo(res); });
+
+    auto fd = ::socket(res->ai_family, res->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, res->ai_protocol);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "socket"};
+    }
+    int on = 1, off = 0;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (res->ai_family == AF_INET6) {
+        ::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    }
+    if (::bind(fd, res->ai_addr, res->ai_addrlen) == -1 || ::listen(fd, SOMAXCONN) == -1) {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error{err, std::system_category(), "Cannot listen on " + address + ":" + std::to_string(port)};
+    }
+    return fd;
+}
+
+/** How long to wait before accepting again when the process has run out of file descriptors or memory */
+constexpr auto acceptBackoff = std::chrono::milliseconds{100};
+
+std::string peerName(const sockaddr_storage& addr, const socklen_t len)
+{
+    char host[NI_MAXHOST];
+    if (::getnameinfo(reinterpret_cast<const sockaddr*>(&addr), len, host, sizeof(host), nullptr, 0, NI_NUMERICHOST)) {
+        return "unknown";
+    }
+    return host;
+}
+}
+
+CallHomeListener::CallHomeListener(const CallHomeOptions& options)
+    : m_options(options)
+{
+#if defined(NC_ENABLED_SSH_TLS) && defined(HAVE_LIBSSH)
+    impl::ClientInit::instance();
+
+    m_listenFd = listenOn(m_options.address, m_options.port);
+    m_wakeupFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wakeupFd == -1) {
+        auto err = errno;
+        ::close(m_listenFd);
+        throw std::system_error{err, std::system_category(), "eventfd"};
+    }
+
+    for (unsigned i = 0; i < m_options.workers; ++i) {
+        m_workers.emplace_back([this](std::stop_token stop) { workerLoop(stop); });
+    }
+    m_acceptor = std::jthread{[this](std::stop_token stop) { acceptLoop(stop); }};
+#else
+    throw std::logic_error{"libnetconf2-cpp was built without SSH support"};
+#endif
+}
+
+CallHomeListener::~CallHomeListener()
+{
+    m_acceptor.request_stop();
+    uint64_t one = 1;
+    [[maybe_unused]] auto ignored = ::write(m_wakeupFd, &one, sizeof(one));
+    m_acceptor.join();
+
+    for (auto& worker : m_workers) {
+        worker.request_stop();
+    }
+    m_workers.clear();
+
+    for (const auto& [fd, peer] : m_pending) {
+        ::close(fd);
+    }
+    ::close(m_wakeupFd);
+    ::close(m_listenFd);
+}
+
+/** @short The local port, useful when the listener was created with port 0 */
+uint16_t CallHomeListener::port() const
+{
+    sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    if (::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &len) == -1) {
+        throw std::system_error{errno, std::system_category(), "getsockname"};
+    }
+    if (addr.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&addr)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<const sockaddr_in*>(&addr)->sin_port);
+}
+
+/** @short Returns the next established session, or nullptr if none has arrived within @p timeout
+
+Once the listener cannot wait for connections anymore, this throws the error which has stopped it, after all sessions
+which had been established before have been returned.
+*/
+std::unique_ptr<Session> CallHomeListener::accept(const std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock{m_establishedMtx};
+    if (!m_establishedCv.wait_for(lock, timeout, [this] { return !m_established.empty() || m_acceptError; })) {
+        return nullptr;
+    }
+    if (m_established.empty()) {
+        std::rethrow_exception(m_acceptError);
+    }
+    auto session = std::move(m_established.front());
+    m_established.pop_front();
+    return session;
+}
+
+void CallHomeListener::acceptLoop(std::stop_token stop)
+{
+    std::array<pollfd, 2> fds{{{m_listenFd, POLLIN, 0}, {m_wakeupFd, POLLIN, 0}}};
+    while (!stop.stop_requested()) {
+        if (::poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            auto error = std::make_exception_ptr(std::system_error{errno, std::system_category(), "Cannot wait for Call Home connections"});
+            {
+                std::unique_lock lock{m_establishedMtx};
+                m_acceptError = error;
+            }
+            m_establishedCv.notify_all();
+            return;
+        }
+
+        // Drain the whole backlog at once, a reconnect storm typically fills it up
+        while (true) {
+            sockaddr_storage addr;
+            socklen_t len = sizeof(addr);
+            auto fd = ::accept4(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &len, SOCK_CLOEXEC);
+            if (fd == -1) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                if (errno == EMFILE || errno == ENFILE || errno == ENOMEM || errno == ENOBUFS) {
+                    // The pending connection keeps the listening socket readable, polling it right away would spin
+                    pollfd wakeup{m_wakeupFd, POLLIN, 0};
+                    ::poll(&wakeup, 1, acceptBackoff.count());
+                }
+                break;
+            }
+
+            std::unique_lock lock{m_pendingMtx};
+            if (m_pending.size() >= m_options.maxPending) {
+                lock.unlock();
+                ::close(fd);
+                continue;
+            }
+            m_pending.emplace_back(fd, peerName(addr, len));
+            lock.unlock();
+            m_pendingCv.notify_one();
+        }
+    }
+}
+
+void CallHomeListener::workerLoop(std::stop_token stop)
+{
+#if defined(NC_ENABLED_SSH_TLS) && defined(HAVE_LIBSSH)
+    // libnetconf2's client settings are thread-local
+    if (m_options.schemaSearchPath) {
+        nc_client_set_schema_searchpath(m_options.schemaSearchPath->c_str());
+    }
+    // A shared context must not change under the feet of sessions which parse their data in it
+    if (m_options.ctx) {
+        nc_client_set_new_session_context_autofill(0);
+    }
+
+    while (true) {
+        std::unique_lock lock{m_pendingMtx};
+        if (!m_pendingCv.wait(lock, stop, [this] { return !m_pending.empty(); })) {
+            return;
+        }
+        auto [fd, peer] = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+
+        auto ssh = ssh_new();
+        if (!ssh) {
+            ::close(fd);
+            continue;
+        }
+        ssh_options_set(ssh, SSH_OPTIONS_FD, &fd);
+        ssh_options_set(ssh, SSH_OPTIONS_HOST, peer.c_str());
+        ssh_options_set(ssh, SSH_OPTIONS_USER, m_options.ssh.username.c_str());
+
+        auto sshSettings = impl::applySshOptions(m_options.ssh);
+        // On failure, libnetconf2 has already disposed of the SSH session along with the socket, and logged why
+        auto session = nc_connect_libssh(ssh, m_options.ctx ? libyang::retrieveContext(*m_options.ctx) : nullptr);
+        if (!session) {
+            continue;
+        }
+
+        {
+            std::unique_lock established{m_establishedMtx};
+            m_established.emplace_back(std::make_unique<Session>(session));
+        }
+        m_establishedCv.notify_one();
+    }
+#else
+    (void)stop;
+#endif
+}
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <libnetconf2-cpp/columns.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace libnetconf::client {
+
+namespace {
+std::string rowKey(const lyd_node* entry)
+{
+    std::string res;
+    for (auto child = lyd_child(entry); child && child->schema && (child->schema->flags & LYS_KEY); child = child->next) {
+        if (!res.empty()) {
+            res += ',';
+        }
+        res += lyd_get_value(child);
+    }
+    return res;
+}
+
+double decimalValue(const lyd_value& value)
+{
+    auto digits = reinterpret_cast<const lysc_type_dec*>(value.realtype)->fraction_digits;
+    double divisor = 1;
+    for (auto i = 0; i < digits; ++i) {
+        divisor *= 10;
+    }
+    return static_cast<double>(value.dec64) / divisor;
+}
+
+// Unsigned leaves wrap around at the width of their type
+uint64_t wrapMask(const libyang::LeafBaseType type)
+{
+    switch (type) {
+    case libyang::LeafBaseType::Uint8:
+        return std::numeric_limits<uint8_t>::max();
+    case libyang::LeafBaseType::Uint16:
+        return std::numeric_limits<uint16_t>::max();
+    case libyang::LeafBaseType::Uint32:
+        return std::numeric_limits<uint32_t>::max();
+    default:
+        return std::numeric_limits<uint64_t>::max();
+    }
+}
+
+template <typename T>
+T integerValue(const lyd_value& value)
+{
+    switch (value.realtype->basetype) {
+    case LY_TYPE_UINT8:
+        return value.uint8;
+    case LY_TYPE_UINT16:
+        return value.uint16;
+    case LY_TYPE_UINT32:
+        return value.uint32;
+    case LY_TYPE_UINT64:
+        return value.uint64;
+    case LY_TYPE_INT8:
+        return value.int8;
+    case LY_TYPE_INT16:
+        return value.int16;
+    case LY_TYPE_INT32:
+        return value.int32;
+    case LY_TYPE_INT64:
+        return value.int64;
+    default:
+        return 0;
+    }
+}
+}
+
+ColumnExtractor::ColumnExtractor(const libyang::Context& ctx, const std::string& listPath, const std::vector<std::string>& leafPaths)
+    : m_list(ctx, listPath)
+{
+    auto rawCtx = libyang::retrieveContext(ctx);
+    auto list = lys_find_path(rawCtx, nullptr, listPath.c_str(), 0);
+    if (!list || list->nodetype != LYS_LIST) {
+        throw std::invalid_argument{"ColumnExtractor: " + listPath + " is not a list"};
+    }
+
+    for (const auto& leafPath : leafPaths) {
+        auto fullPath = listPath + '/' + leafPath;
+        auto leaf = lys_find_path(rawCtx, nullptr, fullPath.c_str(), 0);
+        if (!leaf || leaf->nodetype != LYS_LEAF) {
+            throw std::invalid_argument{"ColumnExtractor: " + fullPath + " is not a leaf"};
+        }
+
+        const auto basetype = reinterpret_cast<const lysc_node_leaf*>(leaf)->type->basetype;
+        Leaf res{.path = leafPath, .chain = {}, .kind = Kind::Unsigned, .type = static_cast<libyang::LeafBaseType>(basetype)};
+        switch (basetype) {
+        case LY_TYPE_UINT8:
+        case LY_TYPE_UINT16:
+        case LY_TYPE_UINT32:
+        case LY_TYPE_UINT64:
+            res.kind = Kind::Unsigned;
+            break;
+        case LY_TYPE_INT8:
+        case LY_TYPE_INT16:
+        case LY_TYPE_INT32:
+        case LY_TYPE_INT64:
+            res.kind = Kind::Signed;
+            break;
+        case LY_TYPE_DEC64:
+            res.kind = Kind::Decimal;
+            break;
+        default:
+            throw std::invalid_argument{"ColumnExtractor: " + fullPath + " is not numeric"};
+        }
+
+        for (auto node = leaf; node != list; node = node->parent) {
+            if (node->nodetype & (LYS_LIST | LYS_LEAFLIST)) {
+                throw std::invalid_argument{"ColumnExtractor: " + fullPath + " passes through another list"};
+            }
+            if (!(node->nodetype & (LYS_CHOICE | LYS_CASE))) {
+                res.chain.push_back(node);
+            }
+        }
+        std::reverse(res.chain.begin(), res.chain.end());
+        m_leaves.push_back(std::move(res));
+    }
+}
+
+/** @short Extracts the leaves from all entries of the list in the data tree which @p tree belongs to */
+Columns ColumnExtractor::extract(const libyang::DataNode& tree) const
+{
+    Columns res;
+    auto first = m_list.findRaw(libyang::getRawNode(tree));
+
+    size_t rows = 0;
+    for (auto entry = first; entry && entry->schema == first->schema; entry = entry->next) {
+        ++rows;
+    }
+
+    res.keys.reserve(rows);
+    res.columns.resize(m_leaves.size());
+    for (size_t i = 0; i < m_leaves.size(); ++i) {
+        auto& column = res.columns[i];
+        column.path = m_leaves[i].path;
+        column.type = m_leaves[i].type;
+        column.present.resize(rows);
+        switch (m_leaves[i].kind) {
+        case Kind::Unsigned:
+            column.values = std::vector<uint64_t>(rows);
+            break;
+        case Kind::Signed:
+            column.values = std::vector<int64_t>(rows);
+            break;
+        case Kind::Decimal:
+            column.values = std::vector<double>(rows);
+            break;
+        }
+    }
+
+    size_t row = 0;
+    for (auto entry = first; row < rows; entry = entry->next, ++row) {
+        res.keys.push_back(rowKey(entry));
+        for (size_t i = 0; i < m_leaves.size(); ++i) {
+            lyd_node* node = entry;
+            for (const auto* schema : m_leaves[i].chain) {
+                auto children = lyd_child(node);
+                if (!children || lyd_find_sibling_val(children, schema, nullptr, 0, &node) != LY_SUCCESS) {
+                    node = nullptr;
+                    break;
+                }
+            }
+            if (!node) {
+                continue;
+            }
+
+            const auto& value = reinterpret_cast<const lyd_node_term*>(node)->value;
+            auto& column = res.columns[i];
+            column.present[row] = 1;
+            switch (m_leaves[i].kind) {
+            case Kind::Unsigned:
+                std::get<std::vector<uint64_t>>(column.values)[row] = integerValue<uint64_t>(value);
+                break;
+            case Kind::Signed:
+                std::get<std::vector<int64_t>>(column.values)[row] = integerValue<int64_t>(value);
+                break;
+            case Kind::Decimal:
+                std::get<std::vector<double>>(column.values)[row] = decimalValue(value);
+                break;
+            }
+        }
+    }
+    return res;
+}
+
+/** @short Per-second rates of a counter between two extractions
+
+The @p column must be an unsigned one. Rows are matched by their keys, so entries may come and go between the two
+samples. The rate is NaN for rows which are missing from the @p previous sample, or which lack the counter in either
+of them. A counter wraps around at the width of its type, e.g., modulo 2^32 for a yang:counter32, and the rate is
+correct as long as it has wrapped at most once between the two samples.
+*/
+std::vector<double> counterRates(const Columns& previous, const Columns& current, const size_t column, const std::chrono::duration<double> interval)
+{
+    if (column >= previous.columns.size() || column >= current.columns.size()) {
+        throw std::out_of_range{"counterRates: no such column"};
+    }
+    const auto* prevValues = std::get_if<std::vector<uint64_t>>(&previous.columns[column].values);
+    const auto* curValues = std::get_if<std::vector<uint64_t>>(&current.columns[column].values);
+    if (!prevValues || !curValues) {
+        throw std::invalid_argument{"counterRates: not an unsigned column"};
+    }
+    const auto mask = wrapMask(current.columns[column].type);
+
+    const auto rows = current.keys.size();
+    const auto scale = 1.0 / interval.count();
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> res(rows);
+
+    if (previous.keys == current.keys) {
+        // The common case, written so that the compiler can vectorize it
+        const auto* prev = prevValues->data();
+        const auto* cur = curValues->data();
+        const auto* prevPresent = previous.columns[column].present.data();
+        const auto* curPresent = current.columns[column].present.data();
+        auto* out = res.data();
+        for (size_t i = 0; i < rows; ++i) {
+            const auto rate = static_cast<double>((cur[i] - prev[i]) & mask) * scale;
+            out[i] = (prevPresent[i] & curPresent[i]) ? rate : nan;
+        }
+        return res;
+    }
+
+    std::unordered_map<std::string_view, size_t> previousRows;
+    previousRows.reserve(previous.keys.size());
+    for (size_t i = 0; i < previous.keys.size(); ++i) {
+        previousRows.emplace(previous.keys[i], i);
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        auto it = previousRows.find(current.keys[i]);
+        if (it == previousRows.end() || !previous.columns[column].present[it->second] || !current.columns[column].present[i]) {
+            res[i] = nan;
+        } else {
+            res[i] = static_cast<double>(((*curValues)[i] - (*prevValues)[it->second]) & mask) * scale;
+        }
+    }
+    return res;
+}
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <libnetconf2-cpp/compiled-path.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <stdexcept>
+
+namespace libnetconf::client {
+
+CompiledPath::CompiledPath(const libyang::Context& ctx, const std::string& path, const libyang::InputOutputNodes inputOutputNodes)
+    : m_ctx(ctx)
+    , m_path(path)
+{
+    auto node = lys_find_path(libyang::retrieveContext(m_ctx), nullptr, path.c_str(), inputOutputNodes == libyang::InputOutputNodes::Output);
+    if (!node) {
+        throw std::invalid_argument{"CompiledPath: cannot resolve " + path};
+    }
+
+    // Only the nodes which show up in a data tree, i.e., neither choices, cases, nor RPC inputs and outputs
+    for (; node; node = node->parent) {
+        if (!(node->nodetype & (LYS_CHOICE | LYS_CASE | LYS_INPUT | LYS_OUTPUT))) {
+            m_chain.push_back(node);
+        }
+    }
+    std::reverse(m_chain.begin(), m_chain.end());
+
+    if (std::any_of(m_chain.begin(), m_chain.end() - 1, [](const auto* node) { return node->nodetype & (LYS_LIST | LYS_LEAFLIST); })) {
+        throw std::invalid_argument{"CompiledPath: " + path + " passes through a list"};
+    }
+}
+
+/** @short Looks up the node in the data tree which @p tree belongs to, or in its top-level siblings, to be precise
+
+When the path refers to an RPC or an action, @p tree must be its reply. The node is returned as a raw pointer into
+@p tree, for use with libyang's C API.
+*/
+lyd_node* CompiledPath::findRaw(const lyd_node* tree) const
+{
+    auto siblings = tree ? lyd_first_sibling(tree) : nullptr;
+    lyd_node* match = nullptr;
+    for (const auto* schema : m_chain) {
+        if (!siblings || lyd_find_sibling_val(siblings, schema, nullptr, 0, &match) != LY_SUCCESS) {
+            return nullptr;
+        }
+        siblings = lyd_child(match);
+    }
+    return match;
+}
+
+/** @short Looks up the node in the data tree which @p tree belongs to
+
+The returned node refers into @p tree, and it must not be used once @p tree is gone.
+*/
+std::optional<libyang::DataNode> CompiledPath::find(const libyang::DataNode& tree) const
+{
+    if (auto match = findRaw(libyang::getRawNode(tree))) {
+        return libyang::wrapUnmanagedRawNode(match);
+    }
+    return std::nullopt;
+}
+
+/** @short All instances of the list or leaf-list which the path refers to, see find() */
+std::vector<libyang::DataNode> CompiledPath::findAll(const libyang::DataNode& tree) const
+{
+    std::vector<libyang::DataNode> res;
+    // All instances of a node are kept next to each other
+    for (auto match = findRaw(libyang::getRawNode(tree)); match && match->schema == m_chain.back(); match = match->next) {
+        res.push_back(libyang::wrapUnmanagedRawNode(match));
+    }
+    return res;
+}
+
+const std::string& CompiledPath::path() const
+{
+    return m_path;
+}
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <libnetconf2-cpp/context-image.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+
+namespace libnetconf::client {
+
+#ifdef HAVE_LY_CTX_COMPILED_PRINT
+namespace {
+constexpr std::array<char, 8> magic{'N', 'C', '2', 'C', 'T', 'X', '0', '1'};
+
+struct Header {
+    std::array<char, 8> magic;
+    uint64_t address;
+    uint64_t size;
+};
+
+/** The context starts on the second page, so that it is page-aligned and the header can share the mapping */
+constexpr size_t headerSize = 4096;
+
+void* mapAt(const int fd, const uintptr_t address, const size_t length, const int prot, const int flags)
+{
+    auto mem = ::mmap(reinterpret_cast<void*>(address), length, prot, flags | MAP_FIXED_NOREPLACE, fd, 0);
+    if (mem == MAP_FAILED) {
+        std::ostringstream ss;
+        ss << "Cannot map the context image at 0x" << std::hex << address;
+        throw std::system_error{errno, std::system_category(), ss.str()};
+    }
+    if (mem != reinterpret_cast<void*>(address)) {
+        // Kernels older than 4.17 treat the address as a mere hint
+        ::munmap(mem, length);
+        throw std::runtime_error{"The kernel does not support MAP_FIXED_NOREPLACE"};
+    }
+    return mem;
+}
+}
+#endif
+
+/** @short Whether libyang can print compiled contexts, which is needed for both printContextImage() and mapContextImage() */
+bool contextImagesSupported()
+{
+#ifdef HAVE_LY_CTX_COMPILED_PRINT
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** @short The address at which the image at @p path is mapped, unless printContextImage() is told otherwise
+
+A printed context contains absolute pointers, so every process has to map the image at the address it was printed for.
+Each image which is mapped into one process needs its own address, e.g., one per device family, so the address is
+derived from the absolute path of the image. The addresses are spaced 4 GiB apart within an area far away from where
+Linux usually places executables, the heap, shared libraries and other mappings.
+*/
+uintptr_t contextImageAddress(const std::filesystem::path& path)
+{
+    constexpr uintptr_t areaStart = 0x600000000000;
+    constexpr uintptr_t slotSize = uintptr_t{1} << 32;
+    constexpr uintptr_t slots = 4096;
+
+    // FNV-1a, because it has to be the same in every process
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto c : std::filesystem::absolute(path).lexically_normal().native()) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    return areaStart + (hash % slots) * slotSize;
+}
+
+/** @short Prints the compiled @p ctx into a file which other processes can map via mapContextImage()
+
+The image is only valid for the same build of libyang, and it has to be mapped at @p address, which must be free in
+this process while printing, and in every process which maps it. Unless specified, the address comes from
+contextImageAddress(), so images at different paths can be mapped into one process at the same time, and a context
+which itself came from an image can be printed into a different file. Two paths might still end up with the same
+address; when an application maps several images, it can pick their addresses explicitly instead. The file is replaced atomically, so processes which
+are mapping the previous version are not affected. When printing fails, the temporary file is removed and the previous
+image, if any, is kept.
+
+The context of a session which is connected to the same kind of server is a good source of an image: it contains all
+modules which the server announces, with their features, and also those which libnetconf2 itself needs.
+*/
+void printContextImage(const libyang::Context& ctx, const std::filesystem::path& path, const std::optional<uintptr_t>& requestedAddress)
+{
+#ifdef HAVE_LY_CTX_COMPILED_PRINT
+    const auto address = requestedAddress.value_or(contextImageAddress(path));
+    auto raw = libyang::retrieveContext(ctx);
+    auto size = ly_ctx_compiled_size(raw);
+    if (size < 0) {
+        throw std::runtime_error{"Cannot determine the size of the compiled context"};
+    }
+    const auto length = headerSize + static_cast<size_t>(size);
+
+    auto tmp = path;
+    tmp += ".tmp";
+    auto fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot open " + tmp.string()};
+    }
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    bool published = false;
+    auto removeTmp = make_unique_resource([] {}, [&tmp, &published] {
+        if (!published) {
+            ::unlink(tmp.c_str());
+        }
+    });
+    if (::ftruncate(fd, length) == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot resize " + tmp.string()};
+    }
+
+    {
+        auto mem = mapAt(fd, address, length, PROT_READ | PROT_WRITE, MAP_SHARED);
+        auto unmap = make_unique_resource([] {}, [mem, length] { ::munmap(mem, length); });
+
+        Header header{magic, address, static_cast<uint64_t>(size)};
+        std::memcpy(mem, &header, sizeof(header));
+        void* end;
+        if (ly_ctx_compiled_print(raw, static_cast<char*>(mem) + headerSize, &end) != LY_SUCCESS) {
+            throw std::runtime_error{"Cannot print the compiled context"};
+        }
+    }
+
+    std::filesystem::rename(tmp, path);
+    published = true;
+#else
+    (void)ctx;
+    (void)path;
+    (void)requestedAddress;
+    throw std::logic_error{"libnetconf2-cpp was built with a libyang which cannot print compiled contexts"};
+#endif
+}
+
+/** @short Maps an image made by printContextImage() and returns the context in it
+
+No schema is parsed or compiled. The mapping is private: pages which libyang never writes to are shared with the
+page cache and with all other processes which map the same image. The context cannot be modified, i.e., no modules can
+be loaded or implemented and no features changed.
+
+A session can use the context when the image contains all modules which the server announces. When the server announces
+a module which is not in the image, or enables a feature which is disabled in it, libnetconf2 cannot add it to the
+context. It logs a warning, and the session is established without that module: its data in the server's replies are
+not validated against any schema, and requests which contain them fail local validation. Only a missing ietf-netconf,
+which libnetconf2 needs for every session, makes the connection fail.
+*/
+libyang::Context mapContextImage(const std::filesystem::path& path)
+{
+#ifdef HAVE_LY_CTX_COMPILED_PRINT
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot open " + path.string()};
+    }
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+
+    Header header;
+    struct stat st;
+    if (::pread(fd, &header, sizeof(header), 0) != sizeof(header) || header.magic != magic || ::fstat(fd, &st) != 0
+        || static_cast<uint64_t>(st.st_size) != headerSize + header.size) {
+        throw std::runtime_error{path.string() + " is not a context image"};
+    }
+
+    const auto length = headerSize + header.size;
+    auto mem = mapAt(fd, header.address, length, PROT_READ | PROT_WRITE, MAP_PRIVATE);
+    ly_ctx* raw;
+    if (ly_ctx_new_printed(static_cast<char*>(mem) + headerSize, &raw) != LY_SUCCESS) {
+        ::munmap(mem, length);
+        throw std::runtime_error{"Cannot use the context image " + path.string()};
+    }
+    return libyang::createUnmanagedContext(raw, [mem, length](ly_ctx* ctx) {
+        ly_ctx_destroy(ctx);
+        ::munmap(mem, length);
+    });
+#else
+    (void)path;
+    throw std::logic_error{"libnetconf2-cpp was built with a libyang which cannot print compiled contexts"};
+#endif
+}
+}
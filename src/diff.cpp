@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <cstdlib>
+#include <libnetconf2-cpp/diff.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include "UniqueResource.hpp"
+
+namespace libnetconf::client {
+
+namespace {
+std::string nodePath(const lyd_node* node)
+{
+    auto path = lyd_path(node, LYD_PATH_STD, nullptr, 0);
+    auto freePath = make_unique_resource([] {}, [path] { std::free(path); });
+    return path ? path : "";
+}
+
+std::optional<std::string> termValue(const lyd_node* node)
+{
+    if (node->schema->nodetype & LYD_NODE_TERM) {
+        return lyd_get_value(node);
+    }
+    return std::nullopt;
+}
+
+class Differ {
+public:
+    std::vector<Change> changes;
+
+    void created(const lyd_node* node)
+    {
+        changes.push_back({Change::Type::Created, nodePath(node), std::nullopt, termValue(node)});
+    }
+
+    void deleted(const lyd_node* node)
+    {
+        changes.push_back({Change::Type::Deleted, nodePath(node), termValue(node), std::nullopt});
+    }
+
+    /** @short Compares two instances of the same node, i.e., with the same schema node and the same list keys */
+    void node(const lyd_node* oldNode, const lyd_node* newNode)
+    {
+        if (oldNode->schema->nodetype == LYS_LEAF) {
+            if (lyd_compare_single(oldNode, newNode, 0) == LY_ENOT) {
+                changes.push_back({Change::Type::Modified, nodePath(newNode), termValue(oldNode), termValue(newNode)});
+            }
+        } else if (oldNode->schema->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_RPC | LYS_ACTION | LYS_NOTIF)) {
+            siblings(lyd_child(oldNode), lyd_child(newNode));
+        }
+        // Leaf-list instances are matched by their value, and anydata are not compared
+    }
+
+    /** @short Matches instances by a hash lookup of their schema node and keys (or value), so this is linear in the number of nodes */
+    void siblings(const lyd_node* oldFirst, const lyd_node* newFirst)
+    {
+        lyd_node* match;
+        for (auto oldNode = oldFirst; oldNode; oldNode = oldNode->next) {
+            if (!oldNode->schema) {
+                continue;
+            }
+            if (newFirst && lyd_find_sibling_first(newFirst, oldNode, &match) == LY_SUCCESS) {
+                node(oldNode, match);
+            } else {
+                deleted(oldNode);
+            }
+        }
+        for (auto newNode = newFirst; newNode; newNode = newNode->next) {
+            if (!newNode->schema) {
+                continue;
+            }
+            if (!oldFirst || lyd_find_sibling_first(oldFirst, newNode, &match) != LY_SUCCESS) {
+                created(newNode);
+            }
+        }
+    }
+};
+
+const lyd_node* firstSibling(const std::optional<libyang::DataNode>& tree)
+{
+    return tree ? lyd_first_sibling(libyang::getRawNode(*tree)) : nullptr;
+}
+
+const lyd_node* findSubtree(const std::optional<libyang::DataNode>& tree, const std::string& path)
+{
+    lyd_node* match = nullptr;
+    if (!tree || lyd_find_path(libyang::getRawNode(*tree), path.c_str(), 0, &match) != LY_SUCCESS) {
+        return nullptr;
+    }
+    return match;
+}
+}
+
+/** @short Lists the differences between two data trees from the same context
+
+Entire subtrees which were created or deleted are reported as a single change. Leaf-list instances are matched by
+their value, so a changed value shows up as a deletion and a creation, and a change of the order of entries in
+user-ordered lists is not reported at all. Opaque nodes are ignored.
+
+With a @p subtree (a data path which may include predicates), only that part of both trees is compared.
+*/
+std::vector<Change> diff(const std::optional<libyang::DataNode>& oldTree, const std::optional<libyang::DataNode>& newTree, const std::optional<std::string>& subtree)
+{
+    Differ differ;
+    if (!subtree) {
+        differ.siblings(firstSibling(oldTree), firstSibling(newTree));
+        return std::move(differ.changes);
+    }
+
+    auto oldNode = findSubtree(oldTree, *subtree);
+    auto newNode = findSubtree(newTree, *subtree);
+    if (oldNode && newNode) {
+        differ.node(oldNode, newNode);
+    } else if (oldNode) {
+        differ.deleted(oldNode);
+    } else if (newNode) {
+        differ.created(newNode);
+    }
+    return std::move(differ.changes);
+}
+}
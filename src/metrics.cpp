@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <libnetconf2-cpp/metrics.hpp>
+#include <sstream>
+#include <system_error>
+#include <unistd.h>
+#include "metrics.hpp"
+
+namespace libnetconf {
+
+namespace impl {
+std::atomic<client::Metrics*> metrics{nullptr};
+}
+
+namespace client {
+
+namespace {
+constexpr auto relaxed = std::memory_order_relaxed;
+
+std::string_view operationName(const Metrics::Operation op)
+{
+    switch (op) {
+    case Metrics::Operation::Get:
+        return "get";
+    case Metrics::Operation::GetConfig:
+        return "get-config";
+    case Metrics::Operation::GetData:
+        return "get-data";
+    case Metrics::Operation::EditConfig:
+        return "edit-config";
+    case Metrics::Operation::EditData:
+        return "edit-data";
+    case Metrics::Operation::CopyConfig:
+        return "copy-config";
+    case Metrics::Operation::Lock:
+        return "lock";
+    case Metrics::Operation::Unlock:
+        return "unlock";
+    case Metrics::Operation::Validate:
+        return "validate";
+    case Metrics::Operation::Commit:
+        return "commit";
+    case Metrics::Operation::Discard:
+        return "discard-changes";
+    case Metrics::Operation::CancelCommit:
+        return "cancel-commit";
+    case Metrics::Operation::Generic:
+        return "generic";
+    case Metrics::Operation::Other:
+        return "other";
+    }
+    __builtin_unreachable();
+}
+
+std::string_view outcomeName(const Metrics::Outcome outcome)
+{
+    switch (outcome) {
+    case Metrics::Outcome::Ok:
+        return "ok";
+    case Metrics::Outcome::RpcError:
+        return "rpc-error";
+    case Metrics::Outcome::Failed:
+        return "failed";
+    }
+    __builtin_unreachable();
+}
+
+std::string number(const double value)
+{
+    std::array<char, 32> buf;
+    auto [end, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), value, std::chars_format::fixed);
+    return {buf.data(), end};
+}
+
+std::string seconds(const uint64_t nanoseconds)
+{
+    return number(static_cast<double>(nanoseconds) / 1e9);
+}
+
+void header(std::ostringstream& out, const char* name, const char* type, const char* help)
+{
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+}
+
+void Metrics::sessionOpened()
+{
+    m_sessionsOpened.fetch_add(1, relaxed);
+}
+
+void Metrics::sessionClosed()
+{
+    m_sessionsClosed.fetch_add(1, relaxed);
+}
+
+void Metrics::connectFinished(const std::chrono::nanoseconds duration, const bool success)
+{
+    m_connects.fetch_add(1, relaxed);
+    if (!success) {
+        m_connectFailures.fetch_add(1, relaxed);
+    }
+    m_connectNanoseconds.fetch_add(duration.count(), relaxed);
+}
+
+void Metrics::rpcFinished(const Operation op, const Outcome outcome, const std::chrono::nanoseconds duration)
+{
+    m_rpcs[static_cast<size_t>(op)][static_cast<size_t>(outcome)].fetch_add(1, relaxed);
+
+    const auto secs = std::chrono::duration<double>(duration).count();
+    auto bucket = std::lower_bound(latencyBuckets.begin(), latencyBuckets.end(), secs) - latencyBuckets.begin();
+    m_latency[bucket].fetch_add(1, relaxed);
+    m_latencyNanoseconds.fetch_add(duration.count(), relaxed);
+}
+
+void Metrics::rpcErrorReported(std::string_view tag)
+{
+    auto it = std::find(errorTags.begin(), errorTags.end(), tag);
+    m_errorTags[it - errorTags.begin()].fetch_add(1, relaxed);
+}
+
+void Metrics::notificationReceived()
+{
+    m_notifications.fetch_add(1, relaxed);
+}
+
+void Metrics::bytesReceived(const uint64_t bytes)
+{
+    m_receivedBytes.fetch_add(bytes, relaxed);
+}
+
+std::string Metrics::render() const
+{
+    std::ostringstream out;
+
+    const auto opened = m_sessionsOpened.load(relaxed);
+    const auto closed = m_sessionsClosed.load(relaxed);
+    header(out, "netconf_client_sessions_opened_total", "counter", "NETCONF client sessions which were established.");
+    out << "netconf_client_sessions_opened_total " << opened << '\n';
+    header(out, "netconf_client_sessions_active", "gauge", "NETCONF client sessions which are currently open.");
+    out << "netconf_client_sessions_active " << (opened >= closed ? opened - closed : 0) << '\n';
+
+    header(out, "netconf_client_connect_failures_total", "counter", "Attempts to establish a session which have failed.");
+    out << "netconf_client_connect_failures_total " << m_connectFailures.load(relaxed) << '\n';
+    header(out, "netconf_client_connect_duration_seconds", "summary", "Time spent establishing sessions.");
+    out << "netconf_client_connect_duration_seconds_sum " << seconds(m_connectNanoseconds.load(relaxed)) << '\n';
+    out << "netconf_client_connect_duration_seconds_count " << m_connects.load(relaxed) << '\n';
+
+    header(out, "netconf_client_rpcs_total", "counter", "RPCs sent, by operation and outcome.");
+    for (size_t op = 0; op < operationCount; ++op) {
+        for (auto outcome : {Outcome::Ok, Outcome::RpcError, Outcome::Failed}) {
+            if (auto count = m_rpcs[op][static_cast<size_t>(outcome)].load(relaxed)) {
+                out << "netconf_client_rpcs_total{operation=\"" << operationName(static_cast<Operation>(op))
+                    << "\",outcome=\"" << outcomeName(outcome) << "\"} " << count << '\n';
+            }
+        }
+    }
+
+    header(out, "netconf_client_rpc_duration_seconds", "histogram", "Time from sending an RPC until its reply has been parsed.");
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < latencyBuckets.size(); ++i) {
+        cumulative += m_latency[i].load(relaxed);
+        out << "netconf_client_rpc_duration_seconds_bucket{le=\"" << number(latencyBuckets[i]) << "\"} " << cumulative << '\n';
+    }
+    cumulative += m_latency[latencyBuckets.size()].load(relaxed);
+    out << "netconf_client_rpc_duration_seconds_bucket{le=\"+Inf\"} " << cumulative << '\n';
+    out << "netconf_client_rpc_duration_seconds_sum " << seconds(m_latencyNanoseconds.load(relaxed)) << '\n';
+    out << "netconf_client_rpc_duration_seconds_count " << cumulative << '\n';
+
+    header(out, "netconf_client_rpc_errors_total", "counter", "<rpc-error>s received, by error-tag.");
+    for (size_t i = 0; i <= errorTags.size(); ++i) {
+        if (auto count = m_errorTags[i].load(relaxed)) {
+            out << "netconf_client_rpc_errors_total{tag=\"" << (i < errorTags.size() ? errorTags[i] : "other") << "\"} " << count << '\n';
+        }
+    }
+
+    header(out, "netconf_client_notifications_total", "counter", "Notifications received while waiting for RPC replies.");
+    out << "netconf_client_notifications_total " << m_notifications.load(relaxed) << '\n';
+
+    header(out, "netconf_client_received_bytes_total", "counter", "Data received from servers by sessions which go through a relay.");
+    out << "netconf_client_received_bytes_total " << m_receivedBytes.load(relaxed) << '\n';
+
+    return out.str();
+}
+
+void Metrics::renderTo(const int fd) const
+{
+    const auto text = render();
+    size_t written = 0;
+    while (written < text.size()) {
+        auto ret = ::write(fd, text.data() + written, text.size() - written);
+        if (ret == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error{errno, std::system_category(), "Cannot write metrics"};
+        }
+        written += ret;
+    }
+}
+
+/** @short Installs a registry which all sessions created from now on update, or disables metrics when passed a nullptr
+
+The registry must outlive all sessions which were created while it was installed.
+*/
+void setMetrics(Metrics* metrics)
+{
+    impl::metrics.store(metrics, std::memory_order_release);
+}
+}
+}
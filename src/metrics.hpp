@@ -0,0 +1,18 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <libnetconf2-cpp/metrics.hpp>
+
+namespace libnetconf::impl {
+extern std::atomic<client::Metrics*> metrics;
+
+inline client::Metrics* activeMetrics()
+{
+    return metrics.load(std::memory_order_acquire);
+}
+}
@@ -6,135 +6,480 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <limits>
 #include <libyang-cpp/Context.hpp>
 #include <libyang-cpp/DataNode.hpp>
+#include <libyang-cpp/SchemaNode.hpp>
 #include <libnetconf2-cpp/netconf-client.hpp>
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include <libnetconf2-cpp/traffic.hpp>
 #include <mutex>
+#include <random>
+#include <set>
 extern "C" {
 #include <nc_client.h>
 }
 #include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include "ClientInit.hpp"
+#include "MappedFile.hpp"
 #include "UniqueResource.hpp"
+#include "metrics.hpp"
+#include "ssh.hpp"
 #include "utils.hpp"
 
 namespace libnetconf {
 
 namespace impl {
 
-static client::LogCb logCallback;
+// Sessions log from whichever thread they run in, so the callback is replaced atomically, and each call holds on to
+// the callback it is using. Setting a new one does not wait for calls of the old one to finish.
+static std::atomic<std::shared_ptr<const client::LogCb>> logCallback;
+static std::mutex logCallbackSetterMtx;
 
 static void logViaCallback(const nc_session* session, NC_VERB_LEVEL level, const char* message)
 {
-    logCallback(session, libnetconf::utils::toLogLevel(level), message);
+    if (auto callback = logCallback.load(std::memory_order_acquire)) {
+        (*callback)(session, libnetconf::utils::toLogLevel(level), message);
+    }
 }
 
+auto guarded(nc_rpc* ptr)
+{
+    return std::unique_ptr<nc_rpc, decltype([](auto rpc) constexpr { nc_rpc_free(rpc); })>(ptr);
+}
 
-/** @short Initialization of the libnetconf2 library client
+namespace {
+const auto getData_path = "/ietf-netconf-nmda:get-data/data";
+const auto get_path = "/ietf-netconf:get/data";
 
-Just a safe wrapper over nc_client_init and nc_client_destroy, really.
-*/
-class ClientInit {
-    ClientInit()
-    {
-        nc_client_init();
+// Loading or implementing a module recompiles the whole context, and that frees all schema nodes which a CompiledPath
+// refers to. The context can change at any time, even by another session which shares it.
+const client::CompiledPath& cachedPath(std::optional<client::CompiledPath>& cache, uint16_t& changeCount, const libyang::Context& ctx, const char* path)
+{
+    auto currentCount = ly_ctx_get_change_count(libyang::retrieveContext(ctx));
+    if (!cache || changeCount != currentCount) {
+        cache.emplace(ctx, path, libyang::InputOutputNodes::Output);
+        changeCount = currentCount;
     }
+    return *cache;
+}
+}
 
-    ~ClientInit()
-    {
-        nc_client_destroy();
-    }
+using managed_rpc = std::invoke_result_t<decltype(guarded), nc_rpc*>;
 
-public:
-    static ClientInit& instance()
-    {
-        static ClientInit lib;
-        return lib;
+/** @short What the calls of a client session share, reachable via nc_session_get_data() */
+struct CallState {
+    /** Message-ids of the calls which gave up waiting, in the order in which their replies arrive */
+    std::deque<uint64_t> abandonedReplies;
+    /** The registry which was installed when the session was created, so that it sees both its opening and its closing */
+    client::Metrics* metrics = nullptr;
+    /** The relay of the session's traffic, if any, and how much of the data received through it has been reported */
+    client::TrafficRecorder* relay = nullptr;
+    uint64_t accountedBytes = 0;
+};
+
+namespace {
+constexpr auto defaultTimeout = std::chrono::seconds{20};
+/** How often a call checks its stop_token while waiting for a reply */
+constexpr auto cancellationCheckInterval = std::chrono::milliseconds{100};
+
+int remainingMs(const std::chrono::steady_clock::time_point deadline, const std::chrono::milliseconds cap)
+{
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return static_cast<int>(std::clamp(remaining, std::chrono::milliseconds{1}, cap).count());
+}
+
+client::Metrics::Operation metricsOperation(const nc_rpc* rpc)
+{
+    using Operation = client::Metrics::Operation;
+    switch (nc_rpc_get_type(rpc)) {
+    case NC_RPC_GET:
+        return Operation::Get;
+    case NC_RPC_GETCONFIG:
+        return Operation::GetConfig;
+    case NC_RPC_GETDATA:
+        return Operation::GetData;
+    case NC_RPC_EDIT:
+        return Operation::EditConfig;
+    case NC_RPC_EDITDATA:
+        return Operation::EditData;
+    case NC_RPC_COPY:
+        return Operation::CopyConfig;
+    case NC_RPC_LOCK:
+        return Operation::Lock;
+    case NC_RPC_UNLOCK:
+        return Operation::Unlock;
+    case NC_RPC_VALIDATE:
+        return Operation::Validate;
+    case NC_RPC_COMMIT:
+        return Operation::Commit;
+    case NC_RPC_DISCARD:
+        return Operation::Discard;
+    case NC_RPC_CANCEL:
+        return Operation::CancelCommit;
+    case NC_RPC_ACT_GENERIC:
+        return Operation::Generic;
+    default:
+        return Operation::Other;
     }
+}
+}
+
+std::string nodeValue(const libyang::DataNode& node)
+{
+    return node.isOpaque() ? std::string{node.asOpaque().value()} : node.asTerm().valueStr();
+}
 
-    ClientInit(const ClientInit&) = delete;
-    ClientInit(ClientInit&&) = delete;
-    ClientInit& operator=(const ClientInit&) = delete;
-    ClientInit& operator=(ClientInit&&) = delete;
+namespace {
+enum class Payload {
+    Edit,
+    Config,
 };
 
-auto guarded(nc_rpc* ptr)
+/** @short Whether @p node, or any of its parents, carries an nc:operation which doesn't need a value */
+bool isBeingRemoved(const lyd_node* node)
 {
-    return std::unique_ptr<nc_rpc, decltype([](auto rpc) constexpr { nc_rpc_free(rpc); })>(ptr);
+    for (; node; node = lyd_parent(node)) {
+        const char* operation = nullptr;
+        if (!node->schema) {
+            for (auto attr = reinterpret_cast<const lyd_node_opaq*>(node)->attr; attr; attr = attr->next) {
+                if (!std::strcmp(attr->name.name, "operation")) {
+                    operation = attr->value;
+                }
+            }
+        } else if (auto meta = lyd_find_meta(node->meta, nullptr, "ietf-netconf:operation")) {
+            operation = lyd_get_meta_value(meta);
+        }
+        if (operation && (!std::strcmp(operation, "delete") || !std::strcmp(operation, "remove"))) {
+            return true;
+        }
+    }
+    return false;
 }
 
-namespace {
-const auto getData_path = "/ietf-netconf-nmda:get-data/data";
-const auto get_path = "/ietf-netconf:get/data";
+std::string nodePath(const lyd_node* node)
+{
+    auto path = lyd_path(node, LYD_PATH_STD, nullptr, 0);
+    auto freePath = make_unique_resource([] {}, [path] { std::free(path); });
+    return path ? path : "";
 }
 
-using managed_rpc = std::invoke_result_t<decltype(guarded), nc_rpc*>;
+client::ErrorInfo libyangError(const ly_err_item* err)
+{
+    client::ErrorInfo res{.type = "application", .tag = "invalid-value", .severity = "error"};
+    if (err->apptag) {
+        res.appTag = err->apptag;
+    }
+    if (err->data_path) {
+        res.path = err->data_path;
+    } else if (err->schema_path) {
+        res.path = err->schema_path;
+    }
+    if (err->msg) {
+        res.message = err->msg;
+    }
+    return res;
+}
+
+[[noreturn]] void throwValidationError(std::vector<client::ErrorInfo> errors)
+{
+    std::string msg;
+    for (const auto& error : errors) {
+        if (error.path) {
+            msg += "Path: " + *error.path + "\n";
+        }
+        msg += "Error: " + error.message.value_or(error.tag) + "\n";
+    }
+    throw client::LocalValidationError{msg, std::move(errors)};
+}
+
+/** @short Checks an edit, or a complete configuration, against the session's schema without sending anything */
+void validateLocally(struct nc_session* session, const char* data, const Payload payload)
+{
+    auto ctx = const_cast<ly_ctx*>(nc_session_get_ctx(session));
+    ly_err_clean(ctx, nullptr);
+
+    lyd_node* tree = nullptr;
+    // Edits are parsed leniently so that nodes which are being deleted do not need a valid value, and then the
+    // resulting opaque nodes are checked one by one
+    const uint32_t parseOptions = payload == Payload::Edit ? LYD_PARSE_ONLY | LYD_PARSE_OPAQ | LYD_PARSE_NO_STATE : LYD_PARSE_STRICT;
+    const uint32_t validationOptions = payload == Payload::Edit ? 0 : LYD_VALIDATE_NO_STATE | LYD_VALIDATE_MULTI_ERROR;
+    auto res = lyd_parse_data_mem(ctx, data, LYD_XML, parseOptions, validationOptions, &tree);
+    auto freeTree = make_unique_resource([] {}, [tree] { lyd_free_all(tree); });
+
+    if (res != LY_SUCCESS) {
+        std::vector<client::ErrorInfo> errors;
+        for (auto err = ly_err_first(ctx); err; err = err->next) {
+            if (err->level == LY_LLERR) {
+                errors.push_back(libyangError(err));
+            }
+        }
+        if (errors.empty()) {
+            errors.push_back({.type = "application", .tag = "invalid-value", .severity = "error", .message = "Cannot parse the data"});
+        }
+        throwValidationError(std::move(errors));
+    }
+
+    std::vector<client::ErrorInfo> errors;
+    lyd_node* top;
+    LY_LIST_FOR(tree, top)
+    {
+        lyd_node* node;
+        LYD_TREE_DFS_BEGIN(top, node)
+        {
+            if (!node->schema) {
+                if (!isBeingRemoved(node)) {
+                    auto opaque = reinterpret_cast<const lyd_node_opaq*>(node);
+                    auto parent = lyd_parent(node);
+                    auto module = ly_ctx_get_module_implemented_ns(ctx, opaque->name.module_ns);
+                    const bool known = module && lys_find_child(parent ? parent->schema : nullptr, module, opaque->name.name, 0, 0, 0);
+                    errors.push_back({
+                        .type = "application",
+                        .tag = known ? "invalid-value" : "unknown-element",
+                        .severity = "error",
+                        .path = nodePath(node),
+                        .message = known ? "Invalid value \"" + std::string{lyd_get_value(node)} + "\" of \"" + opaque->name.name + "\""
+                                         : "Unknown element \"" + std::string{opaque->name.name} + "\"",
+                    });
+                }
+                // Everything below an opaque node is opaque as well
+                LYD_TREE_DFS_continue = 1;
+            }
+            LYD_TREE_DFS_END(top, node);
+        }
+    }
 
-std::optional<libyang::DataNode> do_rpc(struct nc_session* session, managed_rpc&& rpc, const char* dataIdentifier)
+    if (!errors.empty()) {
+        throwValidationError(std::move(errors));
+    }
+}
+}
+
+uint64_t send_rpc(struct nc_session* session, const managed_rpc& rpc, const client::CallOptions& options, const std::chrono::steady_clock::time_point deadline)
 {
     uint64_t msgid;
-    NC_MSG_TYPE msgtype;
 
-    msgtype = nc_send_rpc(session, rpc.get(), 1000, &msgid);
+    if (options.stopToken.stop_requested()) {
+        throw client::Cancelled{"RPC cancelled before sending"};
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+        throw client::TimedOut{"Deadline passed before sending an RPC"};
+    }
+
+    auto msgtype = nc_send_rpc(session, rpc.get(), remainingMs(deadline, std::chrono::milliseconds{1000}), &msgid);
     if (msgtype == NC_MSG_ERROR) {
         throw std::runtime_error{"Failed to send RPC"};
     }
     if (msgtype == NC_MSG_WOULDBLOCK) {
-        throw std::runtime_error{"Timeout sending an RPC"};
+        throw client::TimedOut{"Timeout sending an RPC"};
     }
+    return msgid;
+}
+
+CallState* callState(struct nc_session* session)
+{
+    return static_cast<CallState*>(nc_session_get_data(session));
+}
+
+/** @short The registry which @p session reports to, if any */
+client::Metrics* sessionMetrics(struct nc_session* session)
+{
+    auto state = callState(session);
+    return state ? state->metrics : nullptr;
+}
+
+/** @short Reports the data which the session's relay has received since the last call */
+void accountReceivedBytes(CallState& state)
+{
+    if (state.metrics && state.relay) {
+        auto total = state.relay->bytesToClient();
+        state.metrics->bytesReceived(total - state.accountedBytes);
+        state.accountedBytes = total;
+    }
+}
+
+/** @short Remembers that nobody is going to wait for the reply to @p msgid */
+void abandon(struct nc_session* session, const uint64_t msgid)
+{
+    if (auto state = callState(session)) {
+        state->abandonedReplies.push_back(msgid);
+    }
+}
+
+/** @short Reads and throws away the late replies to calls which were abandoned earlier
+
+Replies arrive in the order in which the RPCs were sent, so all of these precede the reply to @p msgid. When this gives
+up, @p msgid is abandoned as well.
+*/
+void drainAbandoned(struct nc_session* session, const uint64_t msgid, const client::CallOptions& options, const std::chrono::steady_clock::time_point deadline, const std::chrono::milliseconds waitSlice)
+{
+    auto state = callState(session);
+    if (!state || state->abandonedReplies.empty()) {
+        return;
+    }
+    auto abandoned = &state->abandonedReplies;
+
+    // The reply is not going to be used, the type of the RPC only affects how libnetconf2 parses it
+    auto placeholder = guarded(nc_rpc_discard());
+    while (!abandoned->empty()) {
+        if (options.stopToken.stop_requested()) {
+            abandon(session, msgid);
+            throw client::Cancelled{"RPC cancelled while waiting for the replies of abandoned RPCs"};
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            abandon(session, msgid);
+            throw client::TimedOut{"Timed out waiting for the replies of abandoned RPCs"};
+        }
+
+        lyd_node* envp = nullptr;
+        lyd_node* op = nullptr;
+        auto msgtype = nc_recv_reply(session, placeholder.get(), abandoned->front(), remainingMs(deadline, waitSlice), &envp, &op);
+        lyd_free_all(envp);
+        lyd_free_all(op);
+        switch (msgtype) {
+        case NC_MSG_WOULDBLOCK:
+            continue;
+        case NC_MSG_NOTIF:
+            if (auto metrics = sessionMetrics(session)) {
+                metrics->notificationReceived();
+            }
+            continue;
+        case NC_MSG_REPLY_ERR_MSGID:
+            throw std::runtime_error{"Received a wrong reply -- msgid mismatch"};
+        case NC_MSG_ERROR:
+            // A reply which does not fit the placeholder is still consumed, unlike a broken transport
+            if (nc_session_get_status(session) != NC_STATUS_RUNNING) {
+                throw std::runtime_error{"Failed to receive an RPC reply"};
+            }
+            [[fallthrough]];
+        default:
+            abandoned->pop_front();
+        }
+    }
+}
+
+/** @short Waits for the reply to an RPC which has already been sent
+
+Replies arrive in the order in which the RPCs were sent. Replies to abandoned calls are skipped, but apart from that,
+the replies to several outstanding RPCs must be collected in the order in which they were sent.
+*/
+std::optional<libyang::DataNode> recv_reply(struct nc_session* session, const managed_rpc& rpc, const uint64_t msgid, const client::CompiledPath* dataPath, const client::CallOptions& options, const std::chrono::steady_clock::time_point deadline)
+{
+    NC_MSG_TYPE msgtype;
+
+    // Only wake up periodically when somebody can actually cancel us
+    const std::chrono::milliseconds waitSlice = options.stopToken.stop_possible() ? cancellationCheckInterval : defaultTimeout;
+
+    drainAbandoned(session, msgid, options, deadline, waitSlice);
 
     lyd_node* raw_reply;
     lyd_node* envp;
     while (true) {
-        msgtype = nc_recv_reply(session, rpc.get(), msgid, 20000, &envp, &raw_reply);
+        if (options.stopToken.stop_requested()) {
+            abandon(session, msgid);
+            throw client::Cancelled{"RPC cancelled while waiting for a reply"};
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            abandon(session, msgid);
+            throw client::TimedOut{"Timed out waiting for RPC reply"};
+        }
+
+        msgtype = nc_recv_reply(session, rpc.get(), msgid, remainingMs(deadline, waitSlice), &envp, &raw_reply);
+        if (msgtype == NC_MSG_WOULDBLOCK) {
+            // No reply yet, check for cancellation and the deadline before waiting again
+            continue;
+        }
         auto replyInfo = libyang::wrapRawNode(envp);
 
         switch (msgtype) {
         case NC_MSG_ERROR:
             throw std::runtime_error{"Failed to receive an RPC reply"};
-        case NC_MSG_WOULDBLOCK:
-            throw std::runtime_error{"Timed out waiting for RPC reply"};
         case NC_MSG_REPLY_ERR_MSGID:
             throw std::runtime_error{"Received a wrong reply -- msgid mismatch"};
         case NC_MSG_NOTIF:
+            if (auto metrics = sessionMetrics(session)) {
+                metrics->notificationReceived();
+            }
             continue;
         default:
             if (!raw_reply) { // <ok> reply, or empty data node, or error
                 std::string msg;
+                std::vector<client::ErrorInfo> errors;
                 for (const auto& child : replyInfo.child()->siblings()) {
                     if (child.path() == "/ietf-netconf:rpc-reply/rpc-error") {
+                        auto& info = errors.emplace_back();
                         for (const auto& error : child.childrenDfs()) {
                             // Note that error-message is opaque node, rpc-path is opaque node when server sends a response with path from unimplemented models
-                            if (error.path() == "/ietf-netconf:rpc-reply/rpc-error/error-message") {
+                            const auto path = error.path();
+                            if (path == "/ietf-netconf:rpc-reply/rpc-error/error-message") {
+                                info.message = error.asOpaque().value();
                                 msg += "Error: ";
-                                msg += error.asOpaque().value();
+                                msg += *info.message;
                                 msg += "\n";
-                            }
-
-                            if (error.path() == "/ietf-netconf:rpc-reply/rpc-error/error-path") {
+                            } else if (path == "/ietf-netconf:rpc-reply/rpc-error/error-path") {
+                                info.path = nodeValue(error);
                                 msg += "Path: ";
-                                msg += error.isOpaque() ? error.asOpaque().value() : error.asTerm().valueStr();
+                                msg += *info.path;
                                 msg += "\n";
+                            } else if (path == "/ietf-netconf:rpc-reply/rpc-error/error-type") {
+                                info.type = nodeValue(error);
+                            } else if (path == "/ietf-netconf:rpc-reply/rpc-error/error-tag") {
+                                info.tag = nodeValue(error);
+                            } else if (path == "/ietf-netconf:rpc-reply/rpc-error/error-severity") {
+                                info.severity = nodeValue(error);
+                            } else if (path == "/ietf-netconf:rpc-reply/rpc-error/error-app-tag") {
+                                info.appTag = nodeValue(error);
                             }
                         }
+                        if (!info.message && !info.path) {
+                            msg += "Error: " + info.tag + "\n";
+                        }
                     }
                 }
 
-                if (!msg.empty()) {
-                    throw client::ReportedError{msg};
+                if (!errors.empty()) {
+                    throw client::ReportedError{msg, std::move(errors)};
                 }
 
                 return std::nullopt;
             }
             auto wrapped = libyang::wrapRawNode(raw_reply);
 
-            // If we have a dataIdentifier, then we'll need to look for it.
+            // If we have a dataPath, then we'll need to look for it.
             // Some operations don't have that, and then the result data are just the wrapped node.
-            if (!dataIdentifier) {
+            if (!dataPath) {
                 return wrapped;
             }
 
-            auto anydataValue = wrapped.findPath(dataIdentifier, libyang::InputOutputNodes::Output)->asAny().releaseValue();
+            auto anydata = reinterpret_cast<lyd_node_any*>(dataPath->findRaw(raw_reply));
+            if (!anydata) {
+                throw std::runtime_error{"RPC reply is missing " + dataPath->path()};
+            }
+            if (anydata->value_type == LYD_ANYDATA_DATATREE) {
+                // Take over the data tree so that it outlives the reply
+                auto tree = anydata->value.tree;
+                anydata->value.tree = nullptr;
+                if (!tree) {
+                    return std::nullopt;
+                }
+                return libyang::wrapRawNode(tree);
+            }
+
+            auto anydataValue = libyang::wrapUnmanagedRawNode(reinterpret_cast<lyd_node*>(anydata)).asAny().releaseValue();
 
             // If there's no anydata value, then that means we get empty (but valid) data.
             if (!anydataValue) {
@@ -147,13 +492,380 @@ std::optional<libyang::DataNode> do_rpc(struct nc_session* session, managed_rpc&
     __builtin_unreachable();
 }
 
-void do_rpc_ok(struct nc_session* session, managed_rpc&& rpc)
+std::optional<libyang::DataNode> do_rpc_once(struct nc_session* session, const managed_rpc& rpc, const client::CompiledPath* dataPath, const client::CallOptions& options, const std::chrono::steady_clock::time_point deadline)
+{
+    return recv_reply(session, rpc, send_rpc(session, rpc, options, deadline), dataPath, options, deadline);
+}
+
+/** @short Runs @p fn which waits for the reply to @p rpc, and accounts for it in the session's Metrics */
+template <typename Fn>
+auto measured(struct nc_session* session, const managed_rpc& rpc, const std::chrono::steady_clock::time_point start, Fn&& fn) -> decltype(fn())
+{
+    auto state = callState(session);
+    if (!state || !state->metrics) {
+        return fn();
+    }
+
+    using Outcome = client::Metrics::Outcome;
+    const auto op = metricsOperation(rpc.get());
+    try {
+        auto res = fn();
+        state->metrics->rpcFinished(op, Outcome::Ok, std::chrono::steady_clock::now() - start);
+        accountReceivedBytes(*state);
+        return res;
+    } catch (const client::ReportedError& e) {
+        state->metrics->rpcFinished(op, Outcome::RpcError, std::chrono::steady_clock::now() - start);
+        for (const auto& error : e.errors()) {
+            state->metrics->rpcErrorReported(error.tag);
+        }
+        accountReceivedBytes(*state);
+        throw;
+    } catch (...) {
+        state->metrics->rpcFinished(op, Outcome::Failed, std::chrono::steady_clock::now() - start);
+        accountReceivedBytes(*state);
+        throw;
+    }
+}
+
+bool isRetryable(const client::ReportedError& e, const client::RetryPolicy& policy)
+{
+    return std::all_of(e.errors().begin(), e.errors().end(), [&policy](const auto& error) {
+        return std::find(policy.retryOn.begin(), policy.retryOn.end(), error.tag) != policy.retryOn.end();
+    });
+}
+
+/** @short Sleeps for a randomized backoff period, or until a stop is requested */
+void backoff(std::chrono::milliseconds period, const client::RetryPolicy& policy, const std::stop_token& stopToken)
+{
+    thread_local std::mt19937 rng{std::random_device{}()};
+    std::uniform_real_distribution<double> shortenBy{0.0, std::clamp(policy.jitter, 0.0, 1.0)};
+    period = std::chrono::duration_cast<std::chrono::milliseconds>(period * (1.0 - shortenBy(rng)));
+
+    std::mutex mtx;
+    std::condition_variable_any cv;
+    std::unique_lock lock{mtx};
+    cv.wait_for(lock, stopToken, period, [] { return false; });
+}
+
+std::optional<libyang::DataNode> do_rpc(struct nc_session* session, const managed_rpc& rpc, const client::CompiledPath* dataPath, const client::CallOptions& options)
 {
-    auto x = do_rpc(session, std::move(rpc), nullptr);
+    const auto start = std::chrono::steady_clock::now();
+    auto overallDeadline = options.deadline;
+    if (options.retry && options.retry->overallTimeout) {
+        overallDeadline = std::min(overallDeadline.value_or(std::chrono::steady_clock::time_point::max()), start + *options.retry->overallTimeout);
+    }
+
+    std::chrono::milliseconds period{options.retry ? options.retry->initialBackoff : std::chrono::milliseconds{0}};
+    for (unsigned attempt = 1;; ++attempt) {
+        auto attemptDeadline = std::chrono::steady_clock::now() + defaultTimeout;
+        if (overallDeadline) {
+            attemptDeadline = options.deadline ? *overallDeadline : std::min(*overallDeadline, attemptDeadline);
+        }
+
+        try {
+            return measured(session, rpc, std::chrono::steady_clock::now(), [&] {
+                return do_rpc_once(session, rpc, dataPath, options, attemptDeadline);
+            });
+        } catch (const client::ReportedError& e) {
+            if (!options.retry || attempt >= options.retry->maxAttempts || !isRetryable(e, *options.retry)) {
+                throw;
+            }
+            if (overallDeadline && std::chrono::steady_clock::now() + period >= *overallDeadline) {
+                throw;
+            }
+        }
+
+        backoff(period, *options.retry, options.stopToken);
+        period = std::min(std::chrono::duration_cast<std::chrono::milliseconds>(period * options.retry->multiplier), options.retry->maxBackoff);
+    }
+}
+
+void do_rpc_ok(struct nc_session* session, const managed_rpc& rpc, const client::CallOptions& options)
+{
+    auto x = do_rpc(session, rpc, nullptr, options);
     if (x) {
         throw std::runtime_error{"Unexpected DATA reply"};
     }
 }
+
+/** @short Sends all @p rpcs at once, then collects their replies
+
+The server still processes the RPCs one after another, so this saves all round trips but the first one. It also
+means that a failed RPC does not prevent the following ones from being executed. An <rpc-error> is stored at the
+corresponding index of the result, other failures are thrown. The RPCs are never retried.
+
+libnetconf2 does not keep replies to other message-ids aside, so the replies are read strictly in the order in which
+the RPCs were sent. When this gives up on one of them, the replies to all of the following RPCs are still on their way,
+and they are abandoned so that the next call on the session skips them.
+*/
+std::vector<std::exception_ptr> do_rpc_pipelined_ok(struct nc_session* session, const std::vector<managed_rpc>& rpcs, const client::CallOptions& options)
+{
+    const auto deadline = options.deadline.value_or(std::chrono::steady_clock::now() + defaultTimeout);
+    const auto start = std::chrono::steady_clock::now();
+
+    auto abandonFrom = [session](const std::vector<uint64_t>& msgids, const size_t first) {
+        for (auto i = first; i < msgids.size(); ++i) {
+            abandon(session, msgids[i]);
+        }
+    };
+
+    std::vector<uint64_t> msgids;
+    try {
+        for (const auto& rpc : rpcs) {
+            msgids.push_back(send_rpc(session, rpc, options, deadline));
+        }
+    } catch (...) {
+        abandonFrom(msgids, 0);
+        throw;
+    }
+
+    std::vector<std::exception_ptr> res;
+    for (size_t i = 0; i < rpcs.size(); ++i) {
+        try {
+            auto data = measured(session, rpcs[i], start, [&] {
+                return recv_reply(session, rpcs[i], msgids[i], nullptr, options, deadline);
+            });
+            if (data) {
+                throw std::runtime_error{"Unexpected DATA reply"};
+            }
+            res.emplace_back(nullptr);
+        } catch (const client::ReportedError&) {
+            res.emplace_back(std::current_exception());
+        } catch (...) {
+            // recv_reply() has already abandoned this one if its reply is yet to come
+            abandonFrom(msgids, i + 1);
+            throw;
+        }
+    }
+    return res;
+}
+
+std::string moduleKey(const libyang::Module& mod)
+{
+    return mod.name() + '@' + mod.revision().value_or("");
+}
+
+/** @short The modules which libyang puts into each context that libnetconf2 creates for a session */
+const std::set<std::string>& internalModules()
+{
+    static const auto res = [] {
+        std::set<std::string> keys;
+        auto ctx = libyang::Context(std::nullopt,
+                libyang::ContextOptions::NoYangLibrary | libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+        for (const auto& mod : ctx.modules()) {
+            keys.emplace(moduleKey(mod));
+        }
+        return keys;
+    }();
+    return res;
+}
+
+std::optional<std::string> elementText(const std::string& xml, const std::string& name)
+{
+    auto start = xml.find("<" + name + ">");
+    if (start == std::string::npos) {
+        return std::nullopt;
+    }
+    start += name.size() + 2;
+    auto end = xml.find("</" + name + ">", start);
+    if (end == std::string::npos) {
+        return std::nullopt;
+    }
+    return xml.substr(start, end - start);
+}
+
+/** @short Measures how long it takes to establish a session, and which modules had to be loaded for that */
+class ConnectProfiler {
+public:
+    ConnectProfiler(const std::optional<libyang::Context>& ctx)
+    {
+        if (ctx) {
+            for (const auto& mod : ctx->modules()) {
+                m_knownModules.emplace(moduleKey(mod));
+            }
+        } else {
+            m_knownModules = internalModules();
+        }
+        m_metrics = activeMetrics();
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    /** @short Completes the profile, with the details from the messages which went through @p relay, if any */
+    client::ConnectProfile finish(client::Session& session, client::TrafficRecorder* relay) const
+    {
+        client::ConnectProfile res;
+        res.sessionSetup = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+        if (m_metrics) {
+            m_metrics->connectFinished(res.sessionSetup, true);
+        }
+        for (const auto& mod : session.libyangContext().modules()) {
+            if (!m_knownModules.contains(moduleKey(mod))) {
+                res.loadedModules.push_back({mod.name(), mod.revision(), mod.implemented()});
+            }
+        }
+        if (relay) {
+            addPhases(res, *relay);
+        }
+        return res;
+    }
+
+    void failed() const
+    {
+        if (m_metrics) {
+            m_metrics->connectFinished(std::chrono::steady_clock::now() - m_start, false);
+        }
+    }
+
+private:
+    void addPhases(client::ConnectProfile& profile, client::TrafficRecorder& relay) const
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+
+        const auto messages = relay.takeMessages();
+        profile.bytesSent = relay.bytesToServer();
+        profile.bytesReceived = relay.bytesToClient();
+
+        client::ConnectProfile::Phases phases{};
+        if (!messages.toServer.empty() && !messages.toClient.empty()) {
+            phases.hello = duration_cast<microseconds>(std::max(messages.toServer[0].end, messages.toClient[0].end) - m_start);
+        }
+        // Both sides start with a hello, and then each request gets a reply, in order
+        for (size_t i = 1; i < std::min(messages.toServer.size(), messages.toClient.size()); ++i) {
+            const auto& request = messages.toServer[i];
+            const auto duration = duration_cast<microseconds>(messages.toClient[i].end - request.end);
+            if (request.content.find("<get-schema") != std::string::npos) {
+                profile.fetches.push_back({
+                    elementText(request.content, "identifier").value_or(""),
+                    elementText(request.content, "version"),
+                    duration,
+                    messages.toClient[i].bytes,
+                });
+                phases.moduleFetch += duration;
+            } else {
+                phases.moduleDiscovery += duration;
+            }
+        }
+        phases.local = std::max(microseconds{0}, profile.sessionSetup - phases.hello - phases.moduleDiscovery - phases.moduleFetch);
+        profile.phases = phases;
+    }
+
+    std::set<std::string> m_knownModules;
+    client::Metrics* m_metrics;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/** @short Opens a connection to a Unix socket, the way nc_connect_unix() does */
+int connectUnix(const std::string& path)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument{"Socket path too long: " + path};
+    }
+    std::copy(path.begin(), path.end(), addr.sun_path);
+
+    auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "socket"};
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1) {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error{err, std::system_category(), "Cannot connect to " + path};
+    }
+    return fd;
+}
+
+int openForReading(const std::filesystem::path& path)
+{
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot open " + path.string()};
+    }
+    return fd;
+}
+
+const char* terminatedPayload(const std::span<const char> data)
+{
+    if (data.empty() || data.back() != '\0') {
+        throw std::invalid_argument{"The payload must end with a NUL byte"};
+    }
+    return data.data();
+}
+
+#ifdef NC_ENABLED_SSH_TLS
+namespace {
+char* passwordFromOptions(const char*, const char*, void* priv)
+{
+    return ::strdup(static_cast<const std::string*>(priv)->c_str());
+}
+
+void resetSshOptions()
+{
+    nc_client_ssh_set_username(nullptr);
+    while (nc_client_ssh_get_keypair_count() > 0) {
+        nc_client_ssh_del_keypair(0);
+    }
+    nc_client_ssh_set_auth_password_clb(nullptr, nullptr);
+    // libnetconf2's defaults
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_INTERACTIVE, 1);
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_PASSWORD, 2);
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_PUBLICKEY, 3);
+    nc_client_ssh_set_knownhosts_path(nullptr);
+    nc_client_ssh_set_knownhosts_mode(NC_SSH_KNOWNHOSTS_ASK);
+}
+
+void setSshOptions(const client::SshOptions& options)
+{
+    if (nc_client_ssh_set_username(options.username.c_str())) {
+        throw std::runtime_error{"nc_client_ssh_set_username failed"};
+    }
+
+    while (nc_client_ssh_get_keypair_count() > 0) {
+        nc_client_ssh_del_keypair(0);
+    }
+    for (const auto& [pub, priv] : options.keyPairs) {
+        if (nc_client_ssh_add_keypair(pub.c_str(), priv.c_str())) {
+            throw std::runtime_error{"nc_client_ssh_add_keypair failed for " + priv.string()};
+        }
+    }
+
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_PUBLICKEY, options.keyPairs.empty() ? -1 : 3);
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_PASSWORD, options.password ? 2 : -1);
+    nc_client_ssh_set_auth_pref(NC_SSH_AUTH_INTERACTIVE, -1);
+
+    if (options.knownHostsFile && nc_client_ssh_set_knownhosts_path(options.knownHostsFile->c_str())) {
+        throw std::runtime_error{"nc_client_ssh_set_knownhosts_path failed"};
+    }
+    nc_client_ssh_set_knownhosts_mode(utils::toKnownHostsMode(options.knownHosts));
+
+    if (options.password) {
+        nc_client_ssh_set_auth_password_clb(passwordFromOptions, const_cast<std::string*>(&*options.password));
+    }
+}
+}
+
+/** @short Configures libnetconf2's SSH client settings for the duration of a single connect
+
+These settings are thread-local in libnetconf2. All of them (the username, key pairs, password callback, preferred
+authentication methods and the known-hosts file and mode) are reset to libnetconf2's defaults once the returned
+resource goes away, so nothing from this connect is left behind for whatever the calling thread connects next.
+*/
+UniqueResource applySshOptions(const client::SshOptions& options)
+{
+    return make_unique_resource(
+        [&options] {
+            try {
+                setSshOptions(options);
+            } catch (...) {
+                resetSshOptions();
+                throw;
+            }
+        },
+        resetSshOptions);
+}
+#endif
 }
 
 namespace client {
@@ -163,10 +875,19 @@ void setLogLevel(LogLevel level)
     nc_verbosity(utils::toLogLevel(level));
 }
 
+/** @short Sets the function which receives log messages of all sessions, or restores logging to stderr
+
+This may be called at any time, even while other threads are using their sessions.
+*/
 void setLogCallback(const client::LogCb& callback)
 {
-    impl::logCallback = callback;
-    nc_set_print_clb_session(callback ? impl::logViaCallback : NULL);
+    // Concurrent setters must not leave libnetconf2's printer and the stored callback out of sync. The printer is read
+    // by logging sessions without any locking, so it only changes when switching between a callback and stderr.
+    std::unique_lock lock{impl::logCallbackSetterMtx};
+    auto previous = impl::logCallback.exchange(callback ? std::make_shared<const client::LogCb>(callback) : nullptr, std::memory_order_acq_rel);
+    if (static_cast<bool>(previous) != static_cast<bool>(callback)) {
+        nc_set_print_clb_session(callback ? impl::logViaCallback : NULL);
+    }
 }
 
 libyang::Context Session::libyangContext()
@@ -174,39 +895,224 @@ libyang::Context Session::libyangContext()
     return libyang::createUnmanagedContext(const_cast<ly_ctx*>(nc_session_get_ctx(m_session)), nullptr);
 }
 
+/** @short Timing of the session setup and the list of modules which had to be loaded for it
+
+Sessions which were not created through one of the connect*() functions have an empty profile.
+*/
+const ConnectProfile& Session::connectProfile() const
+{
+    return m_connectProfile;
+}
+
 Session::Session(struct nc_session* session)
     : m_session(session)
+    , m_connectProfile{}
+    , m_callState{std::make_unique<impl::CallState>()}
 {
     impl::ClientInit::instance();
+    if (m_session) {
+        nc_session_set_data(m_session, m_callState.get());
+        m_callState->metrics = impl::activeMetrics();
+        if (m_callState->metrics) {
+            m_callState->metrics->sessionOpened();
+        }
+    }
 }
 
 Session::~Session()
 {
     ::nc_session_free(m_session, nullptr);
+    if (m_session && m_callState->metrics) {
+        impl::accountReceivedBytes(*m_callState);
+        m_callState->metrics->sessionClosed();
+    }
+    // The relay might still be polling the owned file descriptor
+    m_recorder.reset();
+    if (m_ownedFd) {
+        ::close(*m_ownedFd);
+    }
 }
 
-std::unique_ptr<Session> Session::connectFd(const int source, const int sink, std::optional<libyang::Context> ctx)
+std::unique_ptr<Session> Session::connectFd(const int source, const int sink, std::optional<libyang::Context> ctx, const ConnectProfiling profiling)
 {
     impl::ClientInit::instance();
 
-    auto session = std::make_unique<Session>(nc_connect_inout(source, sink, ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    std::unique_ptr<TrafficRecorder> relay;
+    if (profiling == ConnectProfiling::Detailed) {
+        relay = std::make_unique<TrafficRecorder>(source, sink, std::nullopt);
+    }
+    impl::ConnectProfiler profiler{ctx};
+    auto session = std::make_unique<Session>(nc_connect_inout(relay ? relay->clientFd() : source, relay ? relay->clientFd() : sink, ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    if (!session->m_session) {
+        profiler.failed();
+        throw std::runtime_error{"nc_connect_inout failed"};
+    }
+    session->m_connectProfile = profiler.finish(*session, relay.get());
+    session->m_recorder = std::move(relay);
+    session->m_callState->relay = session->m_recorder.get();
+    return session;
+}
+
+/** @short Connects to a server which runs in the same process
+
+The session runs over a socketpair, with no relaying, framing or encryption beyond NETCONF itself. libnetconf2 reads and
+writes file descriptors on its own, so each message still passes through the kernel once.
+*/
+std::unique_ptr<Session> Session::connectInProcess(server::Dispatcher& dispatcher, const std::string& username, std::optional<libyang::Context> ctx)
+{
+    impl::ClientInit::instance();
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1) {
+        throw std::system_error{errno, std::system_category(), "socketpair"};
+    }
+
+    // Both sides of the hello exchange block until they hear from each other
+    std::exception_ptr acceptError;
+    std::jthread acceptor{[&dispatcher, &username, &acceptError, fd = fds[0]] {
+        try {
+            dispatcher.acceptOwnedFd(fd, username);
+        } catch (...) {
+            ::close(fd);
+            acceptError = std::current_exception();
+        }
+    }};
+
+    impl::ConnectProfiler profiler{ctx};
+    auto session = std::make_unique<Session>(nc_connect_inout(fds[1], fds[1], ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    session->m_ownedFd = fds[1];
     if (!session->m_session) {
+        // Let the server's side of the hello exchange fail, too
+        ::shutdown(fds[1], SHUT_RDWR);
+    }
+    acceptor.join();
+    if (!session->m_session || acceptError) {
+        profiler.failed();
+        session.reset();
+        if (acceptError) {
+            std::rethrow_exception(acceptError);
+        }
         throw std::runtime_error{"nc_connect_inout failed"};
     }
+    session->m_connectProfile = profiler.finish(*session, nullptr);
     return session;
 }
 
-std::unique_ptr<Session> Session::connectSocket(const std::string& path, std::optional<libyang::Context> ctx)
+/** @short Like connectFd(), but all traffic of the session is also written to @p capture
+
+The capture can be served back to a client via TrafficReplayer.
+*/
+std::unique_ptr<Session> Session::connectFdRecording(const int source, const int sink, const std::filesystem::path& capture, std::optional<libyang::Context> ctx)
 {
     impl::ClientInit::instance();
 
-    auto session = std::make_unique<Session>(nc_connect_unix(path.c_str(), ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    auto recorder = std::make_unique<TrafficRecorder>(source, sink, capture);
+    impl::ConnectProfiler profiler{ctx};
+    auto session = std::make_unique<Session>(nc_connect_inout(recorder->clientFd(), recorder->clientFd(), ctx ? libyang::retrieveContext(*ctx) : nullptr));
     if (!session->m_session) {
-        throw std::runtime_error{"nc_connect_unix failed"};
+        profiler.failed();
+        throw std::runtime_error{"nc_connect_inout failed"};
     }
+    session->m_connectProfile = profiler.finish(*session, recorder.get());
+    session->m_recorder = std::move(recorder);
+    session->m_callState->relay = session->m_recorder.get();
     return session;
 }
 
+/** @short Connects to a NETCONF server on a Unix socket
+
+With ConnectProfiling::Detailed, the socket is opened by this library rather than by libnetconf2, and the session uses
+it as a pair of file descriptors.
+*/
+std::unique_ptr<Session> Session::connectSocket(const std::string& path, std::optional<libyang::Context> ctx, const ConnectProfiling profiling)
+{
+    impl::ClientInit::instance();
+
+    if (profiling == ConnectProfiling::Summary) {
+        impl::ConnectProfiler profiler{ctx};
+        auto session = std::make_unique<Session>(nc_connect_unix(path.c_str(), ctx ? libyang::retrieveContext(*ctx) : nullptr));
+        if (!session->m_session) {
+            profiler.failed();
+            throw std::runtime_error{"nc_connect_unix failed"};
+        }
+        session->m_connectProfile = profiler.finish(*session, nullptr);
+        return session;
+    }
+
+    impl::ConnectProfiler profiler{ctx};
+    auto fd = impl::connectUnix(path);
+    std::unique_ptr<TrafficRecorder> relay;
+    try {
+        relay = std::make_unique<TrafficRecorder>(fd, fd, std::nullopt);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    auto session = std::make_unique<Session>(nc_connect_inout(relay->clientFd(), relay->clientFd(), ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    session->m_ownedFd = fd;
+    session->m_recorder = std::move(relay);
+    session->m_callState->relay = session->m_recorder.get();
+    if (!session->m_session) {
+        profiler.failed();
+        throw std::runtime_error{"nc_connect_inout failed"};
+    }
+    session->m_connectProfile = profiler.finish(*session, session->m_recorder.get());
+    return session;
+}
+
+
+/** @short Connects to a NETCONF server over SSH
+
+Further NETCONF sessions can be opened over the same SSH connection via connectSshChannel().
+*/
+std::unique_ptr<Session> Session::connectSsh(const std::string& host, const uint16_t port, const SshOptions& options, std::optional<libyang::Context> ctx)
+{
+    impl::ClientInit::instance();
+
+#ifdef NC_ENABLED_SSH_TLS
+    auto sshSettings = impl::applySshOptions(options);
+    impl::ConnectProfiler profiler{ctx};
+    auto session = std::make_unique<Session>(nc_connect_ssh(host.c_str(), port, ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    if (!session->m_session) {
+        profiler.failed();
+        throw std::runtime_error{"nc_connect_ssh failed"};
+    }
+    session->m_connectProfile = profiler.finish(*session, nullptr);
+    return session;
+#else
+    (void)host;
+    (void)port;
+    (void)options;
+    (void)ctx;
+    throw std::logic_error{"libnetconf2 was built without SSH support"};
+#endif
+}
+
+/** @short Opens another NETCONF session as a new channel of this session's SSH connection
+
+This skips the TCP connect, the key exchange and the user authentication. The SSH connection stays open until the
+last session which uses it is destroyed, regardless of which one of them has created it.
+*/
+std::unique_ptr<Session> Session::connectSshChannel(std::optional<libyang::Context> ctx)
+{
+#ifdef NC_ENABLED_SSH_TLS
+    if (nc_session_get_ti(m_session) != NC_TI_SSH) {
+        throw std::logic_error{"connectSshChannel: not an SSH session"};
+    }
+    impl::ConnectProfiler profiler{ctx};
+    auto session = std::make_unique<Session>(nc_connect_ssh_channel(m_session, ctx ? libyang::retrieveContext(*ctx) : nullptr));
+    if (!session->m_session) {
+        profiler.failed();
+        throw std::runtime_error{"nc_connect_ssh_channel failed"};
+    }
+    session->m_connectProfile = profiler.finish(*session, nullptr);
+    return session;
+#else
+    (void)ctx;
+    throw std::logic_error{"libnetconf2 was built without SSH support"};
+#endif
+}
+
 std::vector<std::string> Session::capabilities() const
 {
     std::vector<std::string> res;
@@ -218,13 +1124,13 @@ std::vector<std::string> Session::capabilities() const
     return res;
 }
 
-std::optional<libyang::DataNode> Session::get(const std::optional<std::string>& filter)
+std::optional<libyang::DataNode> Session::get(const std::optional<std::string>& filter, const CallOptions& options)
 {
     auto rpc = impl::guarded(nc_rpc_get(filter ? filter->c_str() : nullptr, NC_WD_ALL, NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create get RPC");
     }
-    return impl::do_rpc(m_session, std::move(rpc), impl::get_path);
+    return impl::do_rpc(m_session, rpc, &impl::cachedPath(m_getPath.path, m_getPath.changeCount, libyangContext(), impl::get_path), options);
 }
 
 const char* datastoreToString(NmdaDatastore datastore)
@@ -242,30 +1148,37 @@ const char* datastoreToString(NmdaDatastore datastore)
     __builtin_unreachable();
 }
 
-std::optional<libyang::DataNode> Session::getData(const NmdaDatastore datastore, const std::optional<std::string>& filter)
+std::optional<libyang::DataNode> Session::getData(const NmdaDatastore datastore, const std::optional<std::string>& filter, const CallOptions& options)
 {
     auto rpc = impl::guarded(nc_rpc_getdata(datastoreToString(datastore), filter ? filter->c_str() : nullptr, nullptr, nullptr, 0, 0, 0, 0, NC_WD_ALL, NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create get RPC");
     }
-    return impl::do_rpc(m_session, std::move(rpc), impl::getData_path);
+    return impl::do_rpc(m_session, rpc, &impl::cachedPath(m_getDataPath.path, m_getDataPath.changeCount, libyangContext(), impl::getData_path), options);
 }
 
-void Session::editData(const NmdaDatastore datastore, const std::string& data)
+void Session::editData(const NmdaDatastore datastore, const std::string& data, const CallOptions& options)
 {
+    if (options.validateLocally) {
+        impl::validateLocally(m_session, data.c_str(), impl::Payload::Edit);
+    }
     auto rpc = impl::guarded(nc_rpc_editdata(datastoreToString(datastore), NC_RPC_EDIT_DFLTOP_MERGE, data.c_str(), NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create get RPC");
     }
-    return impl::do_rpc_ok(m_session, std::move(rpc));
+    return impl::do_rpc_ok(m_session, rpc, options);
 }
 
 void Session::editConfig(const Datastore datastore,
                          const EditDefaultOp defaultOperation,
                          const EditTestOpt testOption,
                          const EditErrorOpt errorOption,
-                         const std::string& data)
+                         const std::string& data,
+                         const CallOptions& options)
 {
+    if (options.validateLocally) {
+        impl::validateLocally(m_session, data.c_str(), impl::Payload::Edit);
+    }
     auto rpc = impl::guarded(
             nc_rpc_edit(
                 utils::toDatastore(datastore),
@@ -277,60 +1190,400 @@ void Session::editConfig(const Datastore datastore,
     if (!rpc) {
         throw std::runtime_error("Cannot create edit-config RPC");
     }
-    impl::do_rpc_ok(m_session, std::move(rpc));
+    impl::do_rpc_ok(m_session, rpc, options);
 }
 
-void Session::copyConfigFromString(const Datastore target, const std::string& data)
+/** @short Sends an edit-config whose payload is read straight from a file
+
+The file is memory-mapped and handed over to libnetconf2 as-is, so there's no intermediate std::string copy.
+*/
+void Session::editConfigFromFile(const Datastore datastore,
+                                 const EditDefaultOp defaultOperation,
+                                 const EditTestOpt testOption,
+                                 const EditErrorOpt errorOption,
+                                 const std::filesystem::path& path,
+                                 const CallOptions& options)
+{
+    auto fd = impl::openForReading(path);
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    editConfigFromFd(datastore, defaultOperation, testOption, errorOption, fd, options);
+}
+
+/** @short Sends an edit-config whose payload is the content of a regular file referred to by @p fd */
+void Session::editConfigFromFd(const Datastore datastore,
+                               const EditDefaultOp defaultOperation,
+                               const EditTestOpt testOption,
+                               const EditErrorOpt errorOption,
+                               const int fd,
+                               const CallOptions& options)
+{
+    utils::MappedFile data{fd};
+    editConfigFromMemory(datastore, defaultOperation, testOption, errorOption, {data.c_str(), data.size() + 1}, options);
+}
+
+/** @short Sends an edit-config whose payload is a region of memory, e.g., a file which the caller has mapped
+
+The payload is used in place. libnetconf2 needs a C string, so the last byte of @p data must be a NUL terminator; a
+mapping of a file can get one by reserving one more (zero-filled) byte than the file size.
+*/
+void Session::editConfigFromMemory(const Datastore datastore,
+                                   const EditDefaultOp defaultOperation,
+                                   const EditTestOpt testOption,
+                                   const EditErrorOpt errorOption,
+                                   const std::span<const char> data,
+                                   const CallOptions& options)
+{
+    auto payload = impl::terminatedPayload(data);
+    if (options.validateLocally) {
+        impl::validateLocally(m_session, payload, impl::Payload::Edit);
+    }
+    auto rpc = impl::guarded(
+            nc_rpc_edit(
+                utils::toDatastore(datastore),
+                utils::toDefaultOp(defaultOperation),
+                utils::toTestOpt(testOption),
+                utils::toErrorOpt(errorOption),
+                payload,
+                NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create edit-config RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+void Session::copyConfigFromString(const Datastore target, const std::string& data, const CallOptions& options)
 {
+    if (options.validateLocally) {
+        impl::validateLocally(m_session, data.c_str(), impl::Payload::Config);
+    }
     auto rpc = impl::guarded(nc_rpc_copy(utils::toDatastore(target), nullptr, utils::toDatastore(target) /* yeah, cannot be 0... */, data.c_str(), NC_WD_UNKNOWN, NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create copy-config RPC");
     }
-    impl::do_rpc_ok(m_session, std::move(rpc));
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+/** @short Sends a copy-config whose payload is read straight from a file
+
+The file is memory-mapped and handed over to libnetconf2 as-is, so there's no intermediate std::string copy.
+*/
+void Session::copyConfigFromFile(const Datastore target, const std::filesystem::path& path, const CallOptions& options)
+{
+    auto fd = impl::openForReading(path);
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    copyConfigFromFd(target, fd, options);
+}
+
+/** @short Sends a copy-config whose payload is the content of a regular file referred to by @p fd */
+void Session::copyConfigFromFd(const Datastore target, const int fd, const CallOptions& options)
+{
+    utils::MappedFile data{fd};
+    copyConfigFromMemory(target, {data.c_str(), data.size() + 1}, options);
+}
+
+/** @short Sends a copy-config whose payload is a region of memory, see editConfigFromMemory() */
+void Session::copyConfigFromMemory(const Datastore target, const std::span<const char> data, const CallOptions& options)
+{
+    auto payload = impl::terminatedPayload(data);
+    if (options.validateLocally) {
+        impl::validateLocally(m_session, payload, impl::Payload::Config);
+    }
+    auto rpc = impl::guarded(nc_rpc_copy(utils::toDatastore(target), nullptr, utils::toDatastore(target) /* yeah, cannot be 0... */, payload, NC_WD_UNKNOWN, NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create copy-config RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
 }
 
-void Session::commit()
+void Session::commit(const CallOptions& options)
 {
-    auto rpc = impl::guarded(nc_rpc_commit(0, /* "Optional confirm timeout" how do you optional an uint32_t? */ 0, nullptr, nullptr, NC_PARAMTYPE_CONST));
+    auto rpc = impl::guarded(nc_rpc_commit(0, 0, nullptr, nullptr, NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create commit RPC");
     }
-    impl::do_rpc_ok(m_session, std::move(rpc));
+    impl::do_rpc_ok(m_session, rpc, options);
 }
 
-void Session::discard()
+/** @short Commits the candidate, but reverts that unless it is confirmed within @p timeout
+
+Without @p persist, the commit has to be confirmed by this very session, and it is also reverted when this session
+ends. With @p persist, any session which knows that token can confirm the commit via confirmCommit(), or revert it via
+cancelCommit(), and the commit survives the end of this session.
+*/
+void Session::confirmedCommit(const std::chrono::seconds timeout, const std::optional<std::string>& persist, const CallOptions& options)
+{
+    if (timeout.count() <= 0 || timeout.count() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument{"confirmedCommit: the timeout must be a positive number of seconds"};
+    }
+    auto rpc = impl::guarded(nc_rpc_commit(1, static_cast<uint32_t>(timeout.count()), persist ? persist->c_str() : nullptr, nullptr, NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create commit RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+/** @short Confirms a pending confirmedCommit(), which makes it permanent
+
+The @p persistId is needed when the confirmed commit was made with a persist token.
+*/
+void Session::confirmCommit(const std::optional<std::string>& persistId, const CallOptions& options)
+{
+    auto rpc = impl::guarded(nc_rpc_commit(0, 0, nullptr, persistId ? persistId->c_str() : nullptr, NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create commit RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+/** @short Reverts a pending confirmedCommit() right away
+
+The @p persistId is needed when the confirmed commit was made with a persist token.
+*/
+void Session::cancelCommit(const std::optional<std::string>& persistId, const CallOptions& options)
+{
+    auto rpc = impl::guarded(nc_rpc_cancel(persistId ? persistId->c_str() : nullptr, NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create cancel-commit RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+void Session::discard(const CallOptions& options)
 {
     auto rpc = impl::guarded(nc_rpc_discard());
     if (!rpc) {
         throw std::runtime_error("Cannot create discard RPC");
     }
-    impl::do_rpc_ok(m_session, std::move(rpc));
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+void Session::lock(const Datastore datastore, const CallOptions& options)
+{
+    auto rpc = impl::guarded(nc_rpc_lock(utils::toDatastore(datastore)));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create lock RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+void Session::unlock(const Datastore datastore, const CallOptions& options)
+{
+    auto rpc = impl::guarded(nc_rpc_unlock(utils::toDatastore(datastore)));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create unlock RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+void Session::validate(const Datastore datastore, const CallOptions& options)
+{
+    auto rpc = impl::guarded(nc_rpc_validate(utils::toDatastore(datastore), nullptr, NC_PARAMTYPE_CONST));
+    if (!rpc) {
+        throw std::runtime_error("Cannot create validate RPC");
+    }
+    impl::do_rpc_ok(m_session, rpc, options);
+}
+
+/** @short Starts collecting edits of the candidate datastore, see Transaction */
+Transaction Session::transaction()
+{
+    return Transaction{*this};
 }
 
-std::optional<libyang::DataNode> Session::rpc_or_action(const std::string& xmlData)
+/** @short Iterates over the entries of the list at @p listPath, see ListCursor
+
+The CallOptions apply to each page separately.
+*/
+ListCursor Session::listCursor(const NmdaDatastore datastore, const std::string& listPath, const unsigned pageSize, const CallOptions& options)
+{
+    return ListCursor{*this, datastore, listPath, pageSize, options};
+}
+
+ListCursor::ListCursor(Session& session, const NmdaDatastore datastore, const std::string& listPath, const unsigned pageSize, const CallOptions& options)
+    : m_session(session)
+    , m_datastore(datastore)
+    , m_path(session.libyangContext(), listPath)
+    , m_changeCount(ly_ctx_get_change_count(libyang::retrieveContext(session.libyangContext())))
+    , m_pageSize(pageSize)
+    , m_options(options)
+{
+    if (session.libyangContext().findPath(listPath).nodeType() != libyang::NodeType::List) {
+        throw std::invalid_argument{"ListCursor: " + listPath + " is not a list"};
+    }
+    if (!pageSize) {
+        throw std::invalid_argument{"ListCursor: the page size must not be zero"};
+    }
+}
+
+/** @short Returns the next entry of the list, or std::nullopt when there are no more
+
+The entry refers into the data tree of its page, which stays alive for as long as any of its entries are in use.
+*/
+std::optional<libyang::DataNode> ListCursor::next()
+{
+    if (m_index == m_page.size()) {
+        if (m_lastPage) {
+            return std::nullopt;
+        }
+
+        // Pages are far apart, and the context might have been recompiled in between
+        auto ctx = m_session.libyangContext();
+        if (auto count = ly_ctx_get_change_count(libyang::retrieveContext(ctx)); count != m_changeCount) {
+            m_path = CompiledPath{ctx, m_path.path()};
+            m_changeCount = count;
+        }
+
+        auto filter = m_path.path() + "[position() > " + std::to_string(m_offset) + " and position() <= " + std::to_string(m_offset + m_pageSize) + "]";
+        auto tree = m_session.getData(m_datastore, filter, m_options);
+        m_page = tree ? m_path.findAll(*tree) : std::vector<libyang::DataNode>{};
+        m_index = 0;
+        m_offset += m_page.size();
+        // A short page is the last one, this saves a round trip for an empty one
+        m_lastPage = m_page.size() < m_pageSize;
+        if (m_page.empty()) {
+            return std::nullopt;
+        }
+    }
+    return m_page[m_index++];
+}
+
+Transaction::Transaction(Session& session)
+    : m_session(session)
+{
+}
+
+Transaction& Transaction::editConfig(const EditDefaultOp defaultOperation, const EditTestOpt testOption, const EditErrorOpt errorOption, const std::string& data)
+{
+    m_edits.push_back({defaultOperation, testOption, errorOption, data});
+    return *this;
+}
+
+/** @short Applies all collected edits to the candidate datastore and commits them
+
+The lock is subject to the CallOptions::retry policy, the rest is not retried. The deadline, if any, applies to each of
+the three round trips separately.
+*/
+void Transaction::commit(const CallOptions& options)
+{
+    auto edits = std::move(m_edits);
+    m_edits.clear();
+
+    if (options.validateLocally) {
+        for (const auto& edit : edits) {
+            impl::validateLocally(m_session.m_session, edit.data.c_str(), impl::Payload::Edit);
+        }
+    }
+
+    auto create = [](nc_rpc* rpc, const char* name) {
+        if (!rpc) {
+            throw std::runtime_error(std::string{"Cannot create "} + name + " RPC");
+        }
+        return impl::guarded(rpc);
+    };
+
+    std::vector<impl::managed_rpc> changes;
+    for (const auto& edit : edits) {
+        changes.push_back(create(nc_rpc_edit(NC_DATASTORE_CANDIDATE,
+                                             utils::toDefaultOp(edit.defaultOperation),
+                                             utils::toTestOpt(edit.testOption),
+                                             utils::toErrorOpt(edit.errorOption),
+                                             edit.data.c_str(),
+                                             NC_PARAMTYPE_CONST),
+                                 "edit-config"));
+    }
+    changes.push_back(create(nc_rpc_validate(NC_DATASTORE_CANDIDATE, nullptr, NC_PARAMTYPE_CONST), "validate"));
+
+    m_session.lock(Datastore::Candidate, options);
+
+    std::vector<std::exception_ptr> results;
+    try {
+        results = impl::do_rpc_pipelined_ok(m_session.m_session, changes, options);
+    } catch (...) {
+        // The call was abandoned, or the transport failed. Unless the session is gone, try to leave the candidate as it
+        // was anyway. The replies to the edits are still on their way, so the discard waits for them first, with a
+        // deadline of its own.
+        if (nc_session_get_status(m_session.m_session) == NC_STATUS_RUNNING) {
+            try {
+                m_session.discard();
+                m_session.unlock(Datastore::Candidate);
+            } catch (...) {
+            }
+        }
+        throw;
+    }
+    auto failed = std::find_if(results.begin(), results.end(), [](const auto& e) { return e != nullptr; });
+
+    std::vector<impl::managed_rpc> finish;
+    if (failed == results.end()) {
+        finish.push_back(create(nc_rpc_commit(0, 0, nullptr, nullptr, NC_PARAMTYPE_CONST), "commit"));
+    }
+    // After a successful commit, the candidate is identical to running and this does nothing. Otherwise it drops our edits.
+    finish.push_back(create(nc_rpc_discard(), "discard-changes"));
+    finish.push_back(create(nc_rpc_unlock(NC_DATASTORE_CANDIDATE), "unlock"));
+    auto finished = impl::do_rpc_pipelined_ok(m_session.m_session, finish, options);
+
+    if (failed != results.end()) {
+        std::rethrow_exception(*failed);
+    }
+    for (const auto& e : finished) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+std::optional<libyang::DataNode> Session::rpc_or_action(const std::string& xmlData, const CallOptions& options)
 {
     auto rpc = impl::guarded(nc_rpc_act_generic_xml(xmlData.c_str(), NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create generic RPC");
     }
 
-    return impl::do_rpc(m_session, std::move(rpc), nullptr);
+    return impl::do_rpc(m_session, rpc, nullptr, options);
 }
 
-void Session::copyConfig(const Datastore source, const Datastore destination)
+void Session::copyConfig(const Datastore source, const Datastore destination, const CallOptions& options)
 {
     auto rpc = impl::guarded(nc_rpc_copy(utils::toDatastore(destination), nullptr, utils::toDatastore(source), nullptr, NC_WD_UNKNOWN, NC_PARAMTYPE_CONST));
     if (!rpc) {
         throw std::runtime_error("Cannot create copy-config RPC");
     }
-    impl::do_rpc_ok(m_session, std::move(rpc));
+    impl::do_rpc_ok(m_session, rpc, options);
 }
 
-ReportedError::ReportedError(const std::string& what)
+ReportedError::ReportedError(const std::string& what, std::vector<ErrorInfo> errors)
     : std::runtime_error(what)
+    , m_errors(std::move(errors))
+{
+}
+
+/** @short The individual <rpc-error> elements of the reply */
+const std::vector<ErrorInfo>& ReportedError::errors() const
 {
+    return m_errors;
 }
 
 ReportedError::~ReportedError() = default;
+
+Cancelled::Cancelled(const std::string& what)
+    : std::runtime_error(what)
+{
+}
+
+Cancelled::~Cancelled() = default;
+
+TimedOut::TimedOut(const std::string& what)
+    : std::runtime_error(what)
+{
+}
+
+TimedOut::~TimedOut() = default;
+
+LocalValidationError::LocalValidationError(const std::string& what, std::vector<ErrorInfo> errors)
+    : ReportedError(what, std::move(errors))
+{
+}
+
+LocalValidationError::~LocalValidationError() = default;
 }
 }
@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <unistd.h>
+#include <utility>
+extern "C" {
+#include <nc_server.h>
+}
+#include "UniqueResource.hpp"
+
+namespace libnetconf {
+
+namespace impl {
+
+/** @short Initialization of the libnetconf2 library server
+
+Just a safe wrapper over nc_server_init and nc_server_destroy, really.
+*/
+class ServerInit {
+    ServerInit()
+    {
+        if (nc_server_init()) {
+            throw std::runtime_error{"nc_server_init failed"};
+        }
+    }
+
+    ~ServerInit()
+    {
+        nc_server_destroy();
+    }
+
+public:
+    static ServerInit& instance()
+    {
+        static ServerInit lib;
+        return lib;
+    }
+
+    ServerInit(const ServerInit&) = delete;
+    ServerInit(ServerInit&&) = delete;
+    ServerInit& operator=(const ServerInit&) = delete;
+    ServerInit& operator=(ServerInit&&) = delete;
+};
+
+nc_server_reply* errorReply(nc_session* session, NC_ERR tag, const char* message)
+{
+    auto err = nc_err(nc_session_get_ctx(session), tag, NC_ERR_TYPE_APP);
+    nc_err_set_msg(err, message, "en");
+    return nc_server_reply_err(err);
+}
+
+/** @short The RPC, or the action within the tree that libnetconf2 has received */
+libyang::DataNode operationNode(const libyang::DataNode& tree)
+{
+    if (tree.schema().nodeType() == libyang::NodeType::RPC) {
+        return tree;
+    }
+    for (const auto& node : tree.childrenDfs()) {
+        if (node.schema().nodeType() == libyang::NodeType::Action) {
+            return node;
+        }
+    }
+    throw std::logic_error{"No RPC or action in " + tree.path()};
+}
+}
+
+namespace server {
+
+RpcError::RpcError(const std::string& what)
+    : std::runtime_error(what)
+{
+}
+
+RpcError::~RpcError() = default;
+
+Session::Session(Dispatcher& dispatcher, const uint32_t id)
+    : m_dispatcher(&dispatcher)
+    , m_id(id)
+{
+}
+
+Session::Session(Session&& other) noexcept
+    : m_dispatcher(std::exchange(other.m_dispatcher, nullptr))
+    , m_id(other.m_id)
+{
+}
+
+Session::~Session()
+{
+    if (m_dispatcher) {
+        m_dispatcher->terminate(m_id);
+    }
+}
+
+/** @short The NETCONF session-id */
+uint32_t Session::id() const
+{
+    return m_id;
+}
+
+Dispatcher::Dispatcher(libyang::Context ctx, const unsigned workers)
+    : Dispatcher(ctx, {Lane{defaultLane, workers, 0}})
+{
+}
+
+Dispatcher::Dispatcher(libyang::Context ctx, const std::vector<Lane>& lanes)
+    : m_ctx(ctx)
+    , m_ps(nullptr)
+    , m_sessionCount(0)
+{
+    // The destructor does not run when the constructor throws, so the lanes are checked before anything is allocated
+    size_t workers = 0;
+    for (const auto& lane : lanes) {
+        if (!lane.concurrency) {
+            throw std::invalid_argument{"Lane " + lane.name + " cannot run any handlers"};
+        }
+        auto [it, inserted] = m_lanes.try_emplace(lane.name);
+        if (!inserted) {
+            throw std::invalid_argument{"Duplicate lane " + lane.name};
+        }
+        it->second.concurrency = lane.concurrency;
+        it->second.queueLimit = lane.queueLimit;
+        workers += lane.concurrency + lane.queueLimit;
+    }
+
+    impl::ServerInit::instance();
+
+    auto rawCtx = libyang::retrieveContext(m_ctx);
+    if (nc_server_init_ctx(&rawCtx)) {
+        throw std::runtime_error{"nc_server_init_ctx failed"};
+    }
+    nc_set_global_rpc_clb(dispatch);
+
+    m_ps = nc_ps_new();
+    if (!m_ps) {
+        throw std::runtime_error{"nc_ps_new failed"};
+    }
+
+    for (size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back([this](std::stop_token stop) { workerLoop(stop); });
+    }
+}
+
+Dispatcher::~Dispatcher()
+{
+    for (auto& worker : m_workers) {
+        worker.request_stop();
+    }
+    m_workers.clear();
+    nc_ps_clear(m_ps, 1, nullptr);
+    nc_ps_free(m_ps);
+    for (const auto& [session, fds] : m_ownedFds) {
+        for (const auto fd : fds) {
+            ::close(fd);
+        }
+    }
+}
+
+/** @short Registers a handler for an RPC or action identified by its schema path, e.g., "/example-schema:myRpc"
+
+RPCs without a handler get an operation-not-supported error.
+*/
+void Dispatcher::registerHandler(const std::string& schemaPath, RpcHandler handler, const std::string& lane)
+{
+    auto laneIt = m_lanes.find(lane);
+    if (laneIt == m_lanes.end()) {
+        throw std::invalid_argument{"No such lane: " + lane};
+    }
+    std::unique_lock lock{m_handlersMtx};
+    m_handlers.insert_or_assign(schemaPath, Handler{std::move(handler), &laneIt->second});
+}
+
+/** @short Takes a slot in this lane, possibly after waiting for one. Returns false when the lane is full. */
+bool Dispatcher::LaneState::acquire()
+{
+    std::unique_lock lock{mtx};
+    if (running < concurrency) {
+        ++running;
+        return true;
+    }
+    if (waiting >= queueLimit) {
+        return false;
+    }
+    ++waiting;
+    cv.wait(lock, [this] { return running < concurrency; });
+    --waiting;
+    ++running;
+    return true;
+}
+
+void Dispatcher::LaneState::release()
+{
+    {
+        std::unique_lock lock{mtx};
+        --running;
+    }
+    cv.notify_one();
+}
+
+/** @short Performs the hello exchange on a pair of file descriptors and starts serving that session
+
+The caller remains responsible for closing the file descriptors, but only after the session has terminated.
+*/
+void Dispatcher::acceptFd(const int source, const int sink, const std::string& username)
+{
+    accept(source, sink, username, {});
+}
+
+/** @short Like acceptFd(), but with a bidirectional @p fd, e.g., a socket, which the dispatcher closes along with the session
+
+When this throws, the caller still owns @p fd.
+*/
+void Dispatcher::acceptOwnedFd(const int fd, const std::string& username)
+{
+    accept(fd, fd, username, {fd});
+}
+
+/** @short Like acceptFd(), but the session ends when the returned handle goes away
+
+The dispatcher takes over both file descriptors and closes them once the session is gone. When this throws, the caller
+still owns them.
+*/
+Session Dispatcher::open(const int source, const int sink, const std::string& username)
+{
+    return Session{*this, accept(source, sink, username, source == sink ? std::vector{source} : std::vector{source, sink})};
+}
+
+uint32_t Dispatcher::accept(const int source, const int sink, const std::string& username, const std::vector<int>& ownedFds)
+{
+    nc_session* session = nullptr;
+    auto ret = nc_accept_inout(source, sink, username.c_str(), libyang::retrieveContext(m_ctx), &session);
+    if (ret != NC_MSG_HELLO) {
+        nc_session_free(session, nullptr);
+        throw std::runtime_error{"nc_accept_inout failed"};
+    }
+
+    nc_session_set_data(session, this);
+    const auto id = nc_session_get_id(session);
+    {
+        // Before any worker can see this session terminate
+        std::unique_lock lock{m_registryMtx};
+        m_liveSessions.emplace(id, session);
+        if (!ownedFds.empty()) {
+            m_ownedFds.emplace(session, ownedFds);
+        }
+    }
+    if (nc_ps_add_session(m_ps, session)) {
+        {
+            std::unique_lock lock{m_registryMtx};
+            m_liveSessions.erase(id);
+            m_ownedFds.erase(session);
+        }
+        nc_session_free(session, nullptr);
+        throw std::runtime_error{"nc_ps_add_session failed"};
+    }
+
+    {
+        std::unique_lock lock{m_sessionsMtx};
+        ++m_sessionCount;
+    }
+    m_sessionsCv.notify_all();
+    return id;
+}
+
+/** @short Makes the workers drop a session the next time they poll it, unless it is gone already */
+void Dispatcher::terminate(const uint32_t id)
+{
+    std::unique_lock lock{m_registryMtx};
+    if (auto it = m_liveSessions.find(id); it != m_liveSessions.end()) {
+        nc_session_set_term_reason(it->second, NC_SESSION_TERM_OTHER);
+        nc_session_set_status(it->second, NC_STATUS_INVALID);
+    }
+}
+
+size_t Dispatcher::sessionCount() const
+{
+    return m_sessionCount;
+}
+
+void Dispatcher::workerLoop(std::stop_token stop)
+{
+    while (!stop.stop_requested()) {
+        {
+            // nc_ps_poll() returns right away when there's nothing to poll
+            std::unique_lock lock{m_sessionsMtx};
+            if (!m_sessionsCv.wait(lock, stop, [this] { return m_sessionCount > 0; })) {
+                return;
+            }
+        }
+
+        nc_session* session = nullptr;
+        auto ret = nc_ps_poll(m_ps, 100, &session);
+        if (ret & (NC_PSPOLL_SESSION_TERM | NC_PSPOLL_SESSION_ERROR)) {
+            if (!nc_ps_del_session(m_ps, session)) {
+                std::vector<int> ownedFds;
+                {
+                    std::unique_lock lock{m_registryMtx};
+                    m_liveSessions.erase(nc_session_get_id(session));
+                    if (auto it = m_ownedFds.find(session); it != m_ownedFds.end()) {
+                        ownedFds = std::move(it->second);
+                        m_ownedFds.erase(it);
+                    }
+                }
+                nc_session_free(session, nullptr);
+                --m_sessionCount;
+                for (const auto fd : ownedFds) {
+                    ::close(fd);
+                }
+            }
+        }
+    }
+}
+
+nc_server_reply* Dispatcher::dispatch(lyd_node* rpc, nc_session* session)
+{
+    auto* self = static_cast<Dispatcher*>(nc_session_get_data(session));
+    try {
+        auto op = impl::operationNode(libyang::wrapUnmanagedRawNode(rpc));
+
+        Handler handler;
+        {
+            // A copy, so that registering handlers is held back neither by the ones which are running, nor by RPCs
+            // which wait for a free slot in their lane
+            std::shared_lock lock{self->m_handlersMtx};
+            auto it = self->m_handlers.find(op.schema().path());
+            if (it == self->m_handlers.end()) {
+                return impl::errorReply(session, NC_ERR_OP_NOT_SUPPORTED, ("No handler for " + op.schema().path()).c_str());
+            }
+            handler = it->second;
+        }
+        auto* lane = handler.lane;
+        if (!lane->acquire()) {
+            return impl::errorReply(session, NC_ERR_RES_DENIED, "Too many concurrent requests of this kind, try again later");
+        }
+        auto releaseLane = make_unique_resource([] {}, [lane] { lane->release(); });
+
+        auto username = nc_session_get_username(session);
+        auto output = handler.handler(op, SessionInfo{nc_session_get_id(session), username ? username : ""});
+        if (!output) {
+            return nc_server_reply_ok();
+        }
+        return nc_server_reply_data(libyang::getRawNode(*output), NC_WD_EXPLICIT, NC_PARAMTYPE_DUP_AND_FREE);
+    } catch (std::exception& e) {
+        return impl::errorReply(session, NC_ERR_OP_FAILED, e.what());
+    }
+}
+}
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <fcntl.h>
+#include <libnetconf2-cpp/snapshot.hpp>
+#include <libyang-cpp/Utils.hpp>
+#include <libyang/libyang.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+#include "MappedFile.hpp"
+#include "UniqueResource.hpp"
+
+namespace libnetconf::client {
+
+namespace {
+constexpr std::array<char, 8> magic{'N', 'C', '2', 'L', 'Y', 'B', '0', '1'};
+
+/** The magic, followed by the fingerprint of the context in little-endian byte order, just like in traffic captures */
+constexpr size_t headerSize = magic.size() + sizeof(uint64_t);
+
+std::array<char, headerSize> encodeHeader(uint64_t contextHash)
+{
+    std::array<char, headerSize> res;
+    std::copy(magic.begin(), magic.end(), res.begin());
+    for (auto it = res.begin() + magic.size(); it != res.end(); ++it) {
+        *it = static_cast<char>(contextHash & 0xff);
+        contextHash >>= 8;
+    }
+    return res;
+}
+
+uint64_t decodeContextHash(const char* header)
+{
+    uint64_t res = 0;
+    for (auto i = headerSize; i > magic.size(); --i) {
+        res = (res << 8) | static_cast<unsigned char>(header[i - 1]);
+    }
+    return res;
+}
+
+/** @short A hash of everything in the context which affects the LYB encoding: implemented modules and their features
+
+Modules are sorted by name so that the result does not depend on the order in which they were loaded.
+*/
+uint64_t contextFingerprint(const libyang::Context& ctx)
+{
+    std::vector<std::string> items;
+    for (const auto& mod : ctx.modules()) {
+        if (!mod.implemented()) {
+            continue;
+        }
+        auto item = mod.name() + '@' + mod.revision().value_or("");
+        for (const auto& feature : mod.features()) {
+            if (feature.isEnabled()) {
+                item += ' ' + feature.name();
+            }
+        }
+        items.emplace_back(std::move(item));
+    }
+    std::sort(items.begin(), items.end());
+
+    // FNV-1a, because it has to be stable across processes and library builds
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto& item : items) {
+        for (const auto c : item) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+        }
+        hash = (hash ^ '\n') * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void writeAll(const int fd, const void* buf, size_t len, const std::filesystem::path& path)
+{
+    auto ptr = static_cast<const char*>(buf);
+    while (len) {
+        auto written = ::write(fd, ptr, len);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error{errno, std::system_category(), "Cannot write to " + path.string()};
+        }
+        if (written == 0) {
+            throw std::runtime_error{"Cannot write to " + path.string() + ": no progress"};
+        }
+        ptr += written;
+        len -= written;
+    }
+}
+}
+
+SnapshotMismatch::SnapshotMismatch(const std::string& what)
+    : std::runtime_error(what)
+{
+}
+
+SnapshotMismatch::~SnapshotMismatch() = default;
+
+/** @short Saves @p tree along with all its siblings to @p path in the binary LYB format
+
+The data are printed directly into a temporary file next to @p path, there's no in-memory copy of the serialized form.
+That file replaces @p path only once it is complete and synced to the disk, so neither readers nor a crash can leave a
+truncated snapshot behind.
+*/
+void writeSnapshot(const libyang::DataNode& tree, const std::filesystem::path& path)
+{
+    auto tmp = path;
+    tmp += ".tmp";
+    auto fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot open " + tmp.string()};
+    }
+    bool done = false;
+    auto cleanup = make_unique_resource([] {}, [fd, &tmp, &done] {
+        ::close(fd);
+        if (!done) {
+            ::unlink(tmp.c_str());
+        }
+    });
+
+    auto raw = libyang::getRawNode(tree);
+    auto header = encodeHeader(contextFingerprint(libyang::createUnmanagedContext(const_cast<ly_ctx*>(LYD_CTX(raw)), nullptr)));
+    writeAll(fd, header.data(), header.size(), tmp);
+
+    if (lyd_print_fd(fd, raw, LYD_LYB, LYD_PRINT_WITHSIBLINGS) != LY_SUCCESS) {
+        throw std::runtime_error{"Cannot write snapshot data to " + tmp.string()};
+    }
+
+    // Without this, a crash shortly after the rename could leave an empty or partial file in place of the snapshot
+    if (::fsync(fd) == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot sync " + tmp.string()};
+    }
+    std::filesystem::rename(tmp, path);
+    done = true;
+}
+
+/** @short Loads a snapshot created by writeSnapshot() into @p ctx
+
+Throws SnapshotMismatch when the snapshot was created with a different set of modules or features.
+The data are not validated, they are expected to be a verbatim copy of what the server has sent.
+*/
+std::optional<libyang::DataNode> readSnapshot(const libyang::Context& ctx, const std::filesystem::path& path)
+{
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "Cannot open " + path.string()};
+    }
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    utils::MappedFile data{fd};
+
+    if (data.size() < headerSize) {
+        throw std::runtime_error{"Snapshot " + path.string() + " is truncated"};
+    }
+    if (!std::equal(magic.begin(), magic.end(), data.c_str())) {
+        throw std::runtime_error{"File " + path.string() + " is not a snapshot"};
+    }
+    if (decodeContextHash(data.c_str()) != contextFingerprint(ctx)) {
+        throw SnapshotMismatch{"Snapshot " + path.string() + " was created with a different set of YANG modules"};
+    }
+
+    if (data.size() == headerSize) {
+        return std::nullopt;
+    }
+
+    lyd_node* tree = nullptr;
+    if (lyd_parse_data_mem(libyang::retrieveContext(ctx), data.c_str() + headerSize, LYD_LYB, LYD_PARSE_ONLY | LYD_PARSE_STRICT, 0, &tree) != LY_SUCCESS) {
+        throw std::runtime_error{"Cannot parse snapshot " + path.string()};
+    }
+    if (!tree) {
+        return std::nullopt;
+    }
+    return libyang::wrapRawNode(tree);
+}
+}
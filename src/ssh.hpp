@@ -0,0 +1,13 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include "UniqueResource.hpp"
+
+namespace libnetconf::impl {
+UniqueResource applySshOptions(const client::SshOptions& options);
+}
@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <libnetconf2-cpp/traffic.hpp>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include "MessageCounter.hpp"
+
+namespace libnetconf::client {
+
+namespace {
+constexpr std::array<char, 8> captureMagic{'N', 'C', '2', 'C', 'A', 'P', '0', '1'};
+constexpr size_t relayBufferSize = 64 * 1024;
+constexpr uint8_t toServer = 0;
+constexpr uint8_t toClient = 1;
+
+bool writeAll(const int fd, const char* data, size_t length)
+{
+    while (length) {
+        auto written = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (written == -1 && errno == ENOTSOCK) {
+            written = ::write(fd, data, length);
+        }
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= written;
+    }
+    return true;
+}
+
+ssize_t readSome(const int fd, char* buf, const size_t length)
+{
+    ssize_t res;
+    do {
+        res = ::read(fd, buf, length);
+    } while (res == -1 && errno == EINTR);
+    return res;
+}
+
+// The capture is little-endian so that it can be replayed on a host other than the one which has recorded it
+template <typename T>
+T readScalar(std::ifstream& ifs)
+{
+    std::array<unsigned char, sizeof(T)> buf{};
+    ifs.read(reinterpret_cast<char*>(buf.data()), buf.size());
+    std::make_unsigned_t<T> res = 0;
+    for (auto it = buf.rbegin(); it != buf.rend(); ++it) {
+        res = static_cast<std::make_unsigned_t<T>>(res << 8) | *it;
+    }
+    return static_cast<T>(res);
+}
+
+template <typename T>
+void writeScalar(std::ofstream& ofs, const T value)
+{
+    std::array<char, sizeof(T)> buf;
+    auto raw = static_cast<std::make_unsigned_t<T>>(value);
+    for (auto& byte : buf) {
+        byte = static_cast<char>(raw & 0xff);
+        raw = static_cast<std::make_unsigned_t<T>>(raw >> 8);
+    }
+    ofs.write(buf.data(), buf.size());
+}
+}
+
+TrafficRecorder::TrafficRecorder(const int source, const int sink, const std::optional<std::filesystem::path>& capture)
+    : m_source(source)
+    , m_sink(sink)
+{
+    if (capture) {
+        m_capture.open(*capture, std::ios::binary | std::ios::trunc);
+        if (!m_capture) {
+            throw std::runtime_error{"Cannot open capture file " + capture->string()};
+        }
+        m_capture.write(captureMagic.data(), captureMagic.size());
+    }
+
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1) {
+        throw std::system_error{errno, std::system_category(), "socketpair"};
+    }
+    m_clientFd = fds[0];
+    m_relayFd = fds[1];
+    m_stopFd = ::eventfd(0, EFD_CLOEXEC);
+    if (m_stopFd == -1) {
+        auto err = errno;
+        ::close(m_clientFd);
+        ::close(m_relayFd);
+        throw std::system_error{err, std::system_category(), "eventfd"};
+    }
+
+    m_start = std::chrono::steady_clock::now();
+    m_toServer = std::jthread{[this] { toServerLoop(); }};
+    m_toClient = std::jthread{[this] { toClientLoop(); }};
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+    // The client is gone, so the relay sees an EOF on its end of the socket
+    ::shutdown(m_clientFd, SHUT_RDWR);
+    uint64_t one = 1;
+    [[maybe_unused]] auto _ = ::write(m_stopFd, &one, sizeof(one));
+    m_toServer.join();
+    m_toClient.join();
+    ::close(m_clientFd);
+    ::close(m_relayFd);
+    ::close(m_stopFd);
+}
+
+int TrafficRecorder::clientFd() const
+{
+    return m_clientFd;
+}
+
+uint64_t TrafficRecorder::bytesToServer() const
+{
+    return m_bytesToServer.load(std::memory_order_relaxed);
+}
+
+uint64_t TrafficRecorder::bytesToClient() const
+{
+    return m_bytesToClient.load(std::memory_order_relaxed);
+}
+
+/** @short Returns the messages which have been relayed so far, and stops keeping track of them
+
+A message is in the list before any of its bytes are passed on, so once libnetconf2 has received a reply, the reply
+and the request which it answers are listed here.
+*/
+TrafficRecorder::Messages TrafficRecorder::takeMessages()
+{
+    std::lock_guard lock{m_messagesMtx};
+    m_collecting.store(false, std::memory_order_relaxed);
+    return std::move(m_messages);
+}
+
+void TrafficRecorder::record(const uint8_t direction, const char* data, const size_t length)
+{
+    if (!m_capture.is_open()) {
+        return;
+    }
+    const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+    std::lock_guard lock{m_captureMtx};
+    writeScalar(m_capture, timestamp);
+    writeScalar(m_capture, direction);
+    writeScalar(m_capture, static_cast<uint32_t>(length));
+    m_capture.write(data, length);
+}
+
+void TrafficRecorder::toServerLoop()
+{
+    std::vector<char> buf(relayBufferSize);
+    std::chrono::steady_clock::time_point now;
+    utils::MessageCounter messages;
+    messages.onMessage([this, &now](const std::string& content, const uint64_t bytes) {
+        std::lock_guard lock{m_messagesMtx};
+        if (m_collecting.load(std::memory_order_relaxed)) {
+            m_messages.toServer.push_back({now, bytes, content});
+        }
+    }, true);
+
+    while (true) {
+        auto len = readSome(m_relayFd, buf.data(), buf.size());
+        if (len <= 0) {
+            return;
+        }
+        m_bytesToServer.fetch_add(len, std::memory_order_relaxed);
+        if (m_collecting.load(std::memory_order_relaxed)) {
+            now = std::chrono::steady_clock::now();
+            messages.feed(buf.data(), len);
+        }
+        record(toServer, buf.data(), len);
+        if (!writeAll(m_sink, buf.data(), len)) {
+            return;
+        }
+    }
+}
+
+void TrafficRecorder::toClientLoop()
+{
+    std::vector<char> buf(relayBufferSize);
+    std::chrono::steady_clock::time_point now;
+    utils::MessageCounter messages;
+    messages.onMessage([this, &now](const std::string&, const uint64_t bytes) {
+        std::lock_guard lock{m_messagesMtx};
+        if (m_collecting.load(std::memory_order_relaxed)) {
+            m_messages.toClient.push_back({now, bytes, {}});
+        }
+    }, false);
+
+    std::array<pollfd, 2> fds{{{.fd = m_source, .events = POLLIN, .revents = 0}, {.fd = m_stopFd, .events = POLLIN, .revents = 0}}};
+    while (true) {
+        if (::poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents) {
+            return;
+        }
+        auto len = readSome(m_source, buf.data(), buf.size());
+        if (len <= 0) {
+            return;
+        }
+        m_bytesToClient.fetch_add(len, std::memory_order_relaxed);
+        if (m_collecting.load(std::memory_order_relaxed)) {
+            now = std::chrono::steady_clock::now();
+            messages.feed(buf.data(), len);
+        }
+        record(toClient, buf.data(), len);
+        if (!writeAll(m_relayFd, buf.data(), len)) {
+            return;
+        }
+    }
+}
+
+TrafficReplayer::TrafficReplayer(const std::filesystem::path& capture, const ReplaySpeed speed)
+    : m_speed(speed)
+{
+    std::ifstream ifs{capture, std::ios::binary};
+    std::array<char, captureMagic.size()> magic{};
+    ifs.read(magic.data(), magic.size());
+    if (!ifs || magic != captureMagic) {
+        throw std::runtime_error{"Not a NETCONF traffic capture: " + capture.string()};
+    }
+
+    utils::MessageCounter clientMessages;
+    int64_t lastEvent = 0;
+    while (ifs.peek() != std::ifstream::traits_type::eof()) {
+        auto timestamp = readScalar<int64_t>(ifs);
+        auto direction = readScalar<uint8_t>(ifs);
+        auto length = readScalar<uint32_t>(ifs);
+        std::string data(length, '\0');
+        ifs.read(data.data(), length);
+        if (!ifs) {
+            throw std::runtime_error{"Truncated NETCONF traffic capture: " + capture.string()};
+        }
+
+        if (direction == toServer) {
+            clientMessages.feed(data.data(), data.size());
+        } else {
+            m_chunks.push_back({clientMessages.count(), std::chrono::nanoseconds{timestamp - lastEvent}, std::move(data)});
+        }
+        lastEvent = timestamp;
+    }
+}
+
+/** @short Acts as the server on the given pair of file descriptors until the client closes its end
+
+The file descriptors are not closed.
+*/
+void TrafficReplayer::serve(const int source, const int sink) const
+{
+    utils::MessageCounter clientMessages;
+    std::vector<char> buf(relayBufferSize);
+    auto lastEvent = std::chrono::steady_clock::now();
+
+    for (const auto& chunk : m_chunks) {
+        while (clientMessages.count() < chunk.afterMessages) {
+            auto len = readSome(source, buf.data(), buf.size());
+            if (len <= 0) {
+                return;
+            }
+            clientMessages.feed(buf.data(), len);
+            lastEvent = std::chrono::steady_clock::now();
+        }
+        if (m_speed == ReplaySpeed::Original) {
+            std::this_thread::sleep_until(lastEvent + chunk.delay);
+        }
+        if (!writeAll(sink, chunk.data.data(), chunk.data.size())) {
+            return;
+        }
+        lastEvent = std::chrono::steady_clock::now();
+    }
+
+    while (readSome(source, buf.data(), buf.size()) > 0) {
+    }
+}
+}
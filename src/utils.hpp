@@ -10,6 +10,9 @@
 #include <libnetconf2-cpp/Enum.hpp>
 #include <libnetconf2/log.h>
 #include <libnetconf2/messages_client.h>
+extern "C" {
+#include <nc_client.h>
+}
 
 namespace libnetconf::utils {
 constexpr NC_VERB_LEVEL toLogLevel(const LogLevel level)
@@ -68,4 +71,17 @@ static_assert(toErrorOpt(EditErrorOpt::Unknown) == NC_RPC_EDIT_ERROPT::NC_RPC_ED
 static_assert(toErrorOpt(EditErrorOpt::Stop) == NC_RPC_EDIT_ERROPT::NC_RPC_EDIT_ERROPT_STOP);
 static_assert(toErrorOpt(EditErrorOpt::Continue) == NC_RPC_EDIT_ERROPT::NC_RPC_EDIT_ERROPT_CONTINUE);
 static_assert(toErrorOpt(EditErrorOpt::Rollback) == NC_RPC_EDIT_ERROPT::NC_RPC_EDIT_ERROPT_ROLLBACK);
+
+#ifdef NC_ENABLED_SSH_TLS
+constexpr NC_SSH_KNOWNHOSTS_MODE toKnownHostsMode(const SshKnownHosts mode)
+{
+    return static_cast<NC_SSH_KNOWNHOSTS_MODE>(mode);
+}
+
+static_assert(toKnownHostsMode(SshKnownHosts::Ask) == NC_SSH_KNOWNHOSTS_MODE::NC_SSH_KNOWNHOSTS_ASK);
+static_assert(toKnownHostsMode(SshKnownHosts::Strict) == NC_SSH_KNOWNHOSTS_MODE::NC_SSH_KNOWNHOSTS_STRICT);
+static_assert(toKnownHostsMode(SshKnownHosts::AcceptNew) == NC_SSH_KNOWNHOSTS_MODE::NC_SSH_KNOWNHOSTS_ACCEPT_NEW);
+static_assert(toKnownHostsMode(SshKnownHosts::Accept) == NC_SSH_KNOWNHOSTS_MODE::NC_SSH_KNOWNHOSTS_ACCEPT);
+static_assert(toKnownHostsMode(SshKnownHosts::Skip) == NC_SSH_KNOWNHOSTS_MODE::NC_SSH_KNOWNHOSTS_SKIP);
+#endif
 }
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <cstdlib>
+#include <new>
+#include "allocation_counter.hpp"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+// Plain data in the executable's TLS, which is never allocated on the heap, so these can be used from within malloc()
+thread_local uint64_t mallocs;
+thread_local uint64_t news;
+thread_local uint64_t bytes;
+
+void* counted(void* ptr, const size_t size, uint64_t& counter)
+{
+    ++counter;
+    bytes += size;
+    return ptr;
+}
+
+void* newImpl(const size_t size)
+{
+    if (auto ptr = counted(__libc_malloc(size ? size : 1), size, news)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* newAlignedImpl(const size_t size, const std::align_val_t alignment)
+{
+    if (auto ptr = counted(__libc_memalign(static_cast<size_t>(alignment), size ? size : 1), size, news)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+}
+
+extern "C" {
+void* malloc(size_t size)
+{
+    return counted(__libc_malloc(size), size, mallocs);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    return counted(__libc_calloc(count, size), count * size, mallocs);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    return counted(__libc_realloc(ptr, size), size, mallocs);
+}
+
+void free(void* ptr)
+{
+    __libc_free(ptr);
+}
+}
+
+void* operator new(size_t size)
+{
+    return newImpl(size);
+}
+
+void* operator new[](size_t size)
+{
+    return newImpl(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return counted(__libc_malloc(size ? size : 1), size, news);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return counted(__libc_malloc(size ? size : 1), size, news);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return newAlignedImpl(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return newAlignedImpl(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    __libc_free(ptr);
+}
+
+namespace allocation_counter {
+
+Counts current()
+{
+    return {mallocs, news, bytes};
+}
+
+Scope::Scope()
+    : m_start(current())
+{
+}
+
+/** @short What the current thread has allocated since this object was created */
+Counts Scope::elapsed() const
+{
+    auto now = current();
+    return {now.mallocs - m_start.mallocs, now.news - m_start.news, now.bytes - m_start.bytes};
+}
+}
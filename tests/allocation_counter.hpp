@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Counting of heap allocations made by the current thread. Linking allocation_counter.cpp into an executable replaces
+ * malloc(), calloc(), realloc() and all forms of the global operator new, so that the libraries it uses are counted too.
+ * That does not mix with sanitizers which replace the allocator themselves.
+ */
+namespace allocation_counter {
+
+struct Counts {
+    /** Calls of malloc(), calloc() and realloc(), mostly from the C libraries */
+    uint64_t mallocs = 0;
+    /** Calls of operator new, i.e., C++ code */
+    uint64_t news = 0;
+    /** The number of bytes requested by both */
+    uint64_t bytes = 0;
+
+    uint64_t allocations() const
+    {
+        return mallocs + news;
+    }
+};
+
+Counts current();
+
+/** @short Counts what the current thread allocates from now on */
+class Scope {
+public:
+    Scope();
+    Counts elapsed() const;
+
+private:
+    Counts m_start;
+};
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libyang-cpp/Context.hpp>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+#include "allocation_counter.hpp"
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+/*
+ * Allocation budgets of the main client operations. Only the allocations of the calling thread are counted, so those
+ * of the mock server are not. When an allocation is eliminated, lower the corresponding budget.
+ */
+
+namespace {
+const std::string leafReply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)";
+
+template <typename Fn>
+allocation_counter::Counts measure(Fn&& fn)
+{
+    // The first call fills caches, e.g., the compiled path of the reply's data
+    fn();
+    allocation_counter::Scope scope;
+    fn();
+    auto counts = scope.elapsed();
+    MESSAGE("allocations: ", counts.allocations(), " (malloc: ", counts.mallocs, ", new: ", counts.news, "), bytes: ", counts.bytes);
+    return counts;
+}
+}
+
+TEST_CASE("allocation budgets")
+{
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {.match = {"<get-data", "[small]"}, .reply = leafReply},
+        {.match = {"<get-data", "[10]"}, .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda">)" + mock_server::syntheticInterfaces(10) + "</data>"},
+        {.match = {"<get-data", "[1000]"}, .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda">)" + mock_server::syntheticInterfaces(1000) + "</data>"},
+        {.match = {"<edit-config"}, .reply = "<ok/>"},
+        {.match = {"<get>"}, .reply = R"(<data xmlns="urn:ietf:params:xml:ns:netconf:base:1.0"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)"},
+    }};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto session = libnetconf::client::Session::connectFd(fd, fd, libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd));
+
+    DOCTEST_SUBCASE("getData")
+    {
+        auto counts = measure([&session] { session->getData(libnetconf::NmdaDatastore::Running, "/example-schema:myLeaf[small]"); });
+        REQUIRE(counts.allocations() <= 600);
+        REQUIRE(counts.bytes <= 256 * 1024);
+    }
+
+    DOCTEST_SUBCASE("get")
+    {
+        auto counts = measure([&session] { session->get("/example-schema:myLeaf"); });
+        REQUIRE(counts.allocations() <= 600);
+        REQUIRE(counts.bytes <= 256 * 1024);
+    }
+
+    DOCTEST_SUBCASE("editConfig")
+    {
+        auto counts = measure([&session] {
+            session->editConfig(libnetconf::Datastore::Running, libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::TestSet,
+                                libnetconf::EditErrorOpt::Rollback, R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)");
+        });
+        REQUIRE(counts.allocations() <= 400);
+        REQUIRE(counts.bytes <= 128 * 1024);
+    }
+
+    DOCTEST_SUBCASE("rpc-error")
+    {
+        // Nothing matches a discard-changes, so the server replies with an error
+        auto counts = measure([&session] { REQUIRE_THROWS_AS(session->discard(), libnetconf::client::ReportedError); });
+        REQUIRE(counts.allocations() <= 500);
+        REQUIRE(counts.bytes <= 128 * 1024);
+    }
+
+    DOCTEST_SUBCASE("cost of each list entry")
+    {
+        auto small = measure([&session] { session->getData(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces[10]"); });
+        auto big = measure([&session] { session->getData(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces[1000]"); });
+        // Each entry has seven data nodes
+        REQUIRE((big.allocations() - small.allocations()) / 990 <= 60);
+        REQUIRE((big.bytes - small.bytes) / 990 <= 4096);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libyang-cpp/Context.hpp>
+#include "test-bindings.hpp"
+#include "test_vars.hpp"
+
+using Interfaces = test_bindings::ietf_interfaces::Root::Interfaces;
+static_assert(test_bindings::example_schema::Root::Paths::myLeaf == "/example-schema:myLeaf");
+static_assert(Interfaces::Interface::schemaPath == "/ietf-interfaces:interfaces/interface");
+static_assert(Interfaces::Interface::Statistics::Paths::in_octets == "/ietf-interfaces:interfaces/interface/statistics/in-octets");
+static_assert(std::is_same_v<decltype(Interfaces::Interface::name), std::string>);
+static_assert(std::is_same_v<decltype(Interfaces::Interface::enabled), std::optional<bool>>);
+static_assert(std::is_same_v<decltype(Interfaces::Interface::Statistics::in_octets), std::optional<uint64_t>>);
+
+// Names which would collide in C++
+using Names = test_bindings::example_names::Root::Root_;
+static_assert(std::is_same_v<decltype(test_bindings::example_names::Root::root), Names>);
+static_assert(Names::Paths::foo_bar == "/example-names:root/foo-bar");
+static_assert(Names::Paths::foo_bar_ == "/example-names:root/foo.bar");
+static_assert(Names::Paths::foo_bar_3 == "/example-names:root/foo_bar");
+static_assert(Names::Paths::example_names_augment_foo_bar == "/example-names:root/example-names-augment:foo-bar");
+static_assert(std::is_same_v<decltype(Names::paths), Names::Paths_>);
+static_assert(std::is_same_v<decltype(Names::Paths_::materialize_), std::optional<std::string>>);
+static_assert(std::is_same_v<decltype(Names::example_names_augment_foo_bar), std::optional<int32_t>>);
+
+TEST_CASE("bindings")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+    ctx.loadModule("ietf-interfaces");
+
+    auto tree = ctx.newPath("/example-schema:myLeaf", "AHOJ");
+    tree.newPath("/ietf-interfaces:interfaces/interface[name='eth0']/enabled", "false");
+    tree.newPath("/ietf-interfaces:interfaces/interface[name='eth0']/statistics/in-octets", "18446744073709551615");
+    tree.newPath("/ietf-interfaces:interfaces/interface[name='eth1']/description", "uplink");
+
+    auto example = test_bindings::example_schema::Root::materialize(tree);
+    REQUIRE(example.myLeaf == "AHOJ");
+
+    auto interfaces = test_bindings::ietf_interfaces::Root::materialize(tree).interfaces.interface;
+    REQUIRE(interfaces.size() == 2);
+    REQUIRE(interfaces[0].name == "eth0");
+    REQUIRE(interfaces[0].enabled == false);
+    REQUIRE(interfaces[0].statistics.in_octets == 18446744073709551615u);
+    REQUIRE(!interfaces[0].description);
+    REQUIRE(interfaces[1].name == "eth1");
+    REQUIRE(interfaces[1].description == "uplink");
+    REQUIRE(!interfaces[1].statistics.in_octets);
+
+    REQUIRE(!test_bindings::example_schema::Root::materialize(std::nullopt).myLeaf);
+
+    ctx.loadModule("example-names");
+    ctx.loadModule("example-names-augment");
+    auto names = ctx.newPath("/example-names:root/foo-bar", "dash");
+    names.newPath("/example-names:root/foo_bar", "underscore");
+    names.newPath("/example-names:root/example-names-augment:foo-bar", "42");
+    names.newPath("/example-names:root/paths/materialize", "nested");
+    auto root = test_bindings::example_names::Root::materialize(names).root;
+    REQUIRE(root.foo_bar == "dash");
+    REQUIRE(!root.foo_bar_);
+    REQUIRE(root.foo_bar_3 == "underscore");
+    REQUIRE(root.example_names_augment_foo_bar == 42);
+    REQUIRE(root.paths.materialize_ == "nested");
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <arpa/inet.h>
+#include <doctest/doctest.h>
+#include <future>
+#include <libnetconf2-cpp/callhome.hpp>
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "ssh_server.hpp"
+#include "test_vars.hpp"
+
+namespace {
+/** @short Opens the TCP connection of a device which calls home to the listener */
+int dialOut(const uint16_t port)
+{
+    auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    REQUIRE(fd != -1);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    return fd;
+}
+}
+
+TEST_CASE("call home with a shared context")
+{
+    constexpr auto devices = 8;
+
+    auto serverCtx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    serverCtx.loadModule("example-schema");
+    libnetconf::server::Dispatcher dispatcher{serverCtx, 4};
+    dispatcher.registerHandler("/example-schema:myRpc", [&serverCtx](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+        return std::optional{serverCtx.newPath("/example-schema:myRpc/myOutput", "LOL", libyang::CreationOptions::Output)};
+    });
+
+    // Everything the sessions need is there up front, nothing gets loaded into it later on
+    auto sharedCtx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    sharedCtx.loadModule("ietf-netconf");
+    sharedCtx.loadModule("example-schema");
+    const auto modules = sharedCtx.modules().size();
+
+    libnetconf::client::CallHomeListener listener{{
+        .address = "127.0.0.1",
+        .port = 0,
+        .ssh = {
+            .username = "device",
+            .password = "secret",
+            .knownHosts = libnetconf::SshKnownHosts::Skip,
+        },
+        .workers = 4,
+        .ctx = sharedCtx,
+    }};
+
+    std::vector<std::unique_ptr<ssh_server::SshServer>> calling;
+    for (int i = 0; i < devices; ++i) {
+        calling.emplace_back(std::make_unique<ssh_server::SshServer>(dispatcher, dialOut(listener.port()), "device", "secret"));
+    }
+
+    std::vector<std::unique_ptr<libnetconf::client::Session>> sessions;
+    while (sessions.size() < devices) {
+        auto session = listener.accept(std::chrono::seconds{10});
+        REQUIRE(session);
+        sessions.emplace_back(std::move(session));
+    }
+    REQUIRE(dispatcher.sessionCount() == devices);
+
+    // All sessions parse their replies in the one context at once
+    std::vector<std::future<void>> calls;
+    for (auto& session : sessions) {
+        calls.emplace_back(std::async(std::launch::async, [&session] {
+            for (int i = 0; i < 20; ++i) {
+                auto output = session->rpc_or_action(R"(<myRpc xmlns="http://example.com"/>)");
+                REQUIRE(output);
+                REQUIRE(output->findPath("myOutput", libyang::InputOutputNodes::Output)->asTerm().valueStr() == "LOL");
+            }
+        }));
+    }
+    for (auto& call : calls) {
+        call.get();
+    }
+
+    REQUIRE(sharedCtx.modules().size() == modules);
+}
@@ -14,14 +14,19 @@
 #include <boost/process/v1/pipe.hpp>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <doctest/doctest.h>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <libnetconf2-cpp/netconf-client.hpp>
 #include <optional>
 #include <thread>
+#include <unistd.h>
 #include "UniqueResource.hpp"
+#include "mock_netconf_server.hpp"
 #include "mock_server.hpp"
 #include "test_vars.hpp"
 
@@ -50,6 +55,7 @@ TEST_CASE("client")
     // 2) std::nullopt, if the operation doesn't return any data (e.g. copy-config)
     std::function<std::optional<libyang::DataNode>(std::unique_ptr<libnetconf::client::Session>& session)> testedFunctionality;
     std::string replyData;
+    std::vector<std::string> expectedRpcContent;
     std::string expectedJSON;
     libnetconf::client::LogCb logCb;
     std::string logBuf;
@@ -77,6 +83,31 @@ TEST_CASE("client")
         }
     }
 
+    DOCTEST_SUBCASE("cancellation and deadlines")
+    {
+        testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+            // Neither of these two calls reaches the wire, so the mock server only sees the last one
+            std::stop_source stop;
+            stop.request_stop();
+            REQUIRE_THROWS_AS(session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, {.stopToken = stop.get_token()}),
+                              libnetconf::client::Cancelled);
+            REQUIRE_THROWS_AS(session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, {.deadline = std::chrono::steady_clock::now()}),
+                              libnetconf::client::TimedOut);
+
+            std::stop_source unused;
+            return session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, {
+                .deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10},
+                .stopToken = unused.get_token(),
+            });
+        };
+
+        replyData = createNmdaDataReply(R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)"s);
+        expectedJSON = R"({
+  "example-schema:myLeaf": "AHOJ"
+}
+)";
+    }
+
     DOCTEST_SUBCASE("rpc")
     {
         testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
@@ -148,6 +179,53 @@ TEST_CASE("client")
         replyData = mock_server::OK_REPLY;
     }
 
+    DOCTEST_SUBCASE("copyConfigFromFile")
+    {
+        testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+            auto path = std::filesystem::temp_directory_path() / "libnetconf2-cpp-test-copy-config.xml";
+            std::ofstream{path} << R"(<myLeaf xmlns="http://example.com">FROM-FILE</myLeaf>)";
+            auto removeFile = make_unique_resource([] {}, [path] { std::filesystem::remove(path); });
+            session->copyConfigFromFile(libnetconf::Datastore::Running, path);
+            return std::nullopt;
+        };
+
+        expectedRpcContent = {"<copy-config", "FROM-FILE"};
+        replyData = mock_server::OK_REPLY;
+    }
+
+    DOCTEST_SUBCASE("copyConfigFromMemory")
+    {
+        testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+            // the string literal's own terminator is the last element of the span
+            static const char data[] = R"(<myLeaf xmlns="http://example.com">FROM-MEMORY</myLeaf>)";
+            REQUIRE_THROWS_AS(session->copyConfigFromMemory(libnetconf::Datastore::Running, std::span{data, sizeof(data) - 1}), std::invalid_argument);
+            session->copyConfigFromMemory(libnetconf::Datastore::Running, data);
+            return std::nullopt;
+        };
+
+        expectedRpcContent = {"<copy-config", "FROM-MEMORY"};
+        replyData = mock_server::OK_REPLY;
+    }
+
+    DOCTEST_SUBCASE("editConfigFromFile")
+    {
+        testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+            auto path = std::filesystem::temp_directory_path() / "libnetconf2-cpp-test-edit-config.xml";
+            std::ofstream{path} << R"(<myLeaf xmlns="http://example.com">FROM-FILE</myLeaf>)";
+            auto removeFile = make_unique_resource([] {}, [path] { std::filesystem::remove(path); });
+            session->editConfigFromFile(
+                libnetconf::Datastore::Running,
+                libnetconf::EditDefaultOp::Merge,
+                libnetconf::EditTestOpt::TestSet,
+                libnetconf::EditErrorOpt::Rollback,
+                path);
+            return std::nullopt;
+        };
+
+        expectedRpcContent = {"<edit-config", "FROM-FILE"};
+        replyData = mock_server::OK_REPLY;
+    }
+
     DOCTEST_SUBCASE("editData")
     {
         testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
@@ -181,6 +259,34 @@ TEST_CASE("client")
 )";
         }
 
+        DOCTEST_SUBCASE("structured errors")
+        {
+            testedFunctionality = [](std::unique_ptr<libnetconf::client::Session>& session) {
+                try {
+                    // No retry policy, so there's just one attempt
+                    session->commit();
+                    FAIL("commit() should have thrown");
+                } catch (const libnetconf::client::ReportedError& e) {
+                    REQUIRE(std::string{e.what()} == "Error: lock-denied\n");
+                    REQUIRE(e.errors().size() == 1);
+                    REQUIRE(e.errors()[0].type == "protocol");
+                    REQUIRE(e.errors()[0].tag == "lock-denied");
+                    REQUIRE(e.errors()[0].severity == "error");
+                    REQUIRE(!e.errors()[0].message);
+                    REQUIRE(!e.errors()[0].path);
+                }
+                return std::nullopt;
+            };
+
+            replyData = R"(<rpc-error>
+  <error-type>protocol</error-type>
+  <error-tag>lock-denied</error-tag>
+  <error-severity>error</error-severity>
+  <error-info><session-id>42</session-id></error-info>
+</rpc-error>
+)";
+        }
+
         DOCTEST_SUBCASE("rpc-path contains invalid path")
         {
             testedFunctionality = [](std::unique_ptr<libnetconf::client::Session>& session) {
@@ -218,12 +324,155 @@ TEST_CASE("client")
         replyData = mock_server::OK_REPLY;
     }
 
+    DOCTEST_SUBCASE("confirmed commit")
+    {
+        DOCTEST_SUBCASE("commit")
+        {
+            testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+                REQUIRE_THROWS_AS(session->confirmedCommit(std::chrono::seconds{0}), std::invalid_argument);
+                session->confirmedCommit(std::chrono::seconds{60}, "rollout-1");
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<commit", "<confirmed/>", "<confirm-timeout>60</confirm-timeout>", "<persist>rollout-1</persist>"};
+        }
+
+        DOCTEST_SUBCASE("confirm")
+        {
+            testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+                session->confirmCommit("rollout-1");
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<commit", "<persist-id>rollout-1</persist-id>"};
+        }
+
+        DOCTEST_SUBCASE("cancel")
+        {
+            testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+                session->cancelCommit("rollout-1");
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<cancel-commit", "<persist-id>rollout-1</persist-id>"};
+        }
+
+        replyData = mock_server::OK_REPLY;
+    }
+
+    DOCTEST_SUBCASE("local validation")
+    {
+        // The invalid payloads never reach the wire, so the mock server only sees the valid one
+        auto rejected = [](const std::function<void()>& fn) {
+            try {
+                fn();
+            } catch (const libnetconf::client::LocalValidationError& e) {
+                REQUIRE(!e.errors().empty());
+                return e.errors();
+            }
+            FAIL("The payload should have been rejected");
+            __builtin_unreachable();
+        };
+
+        DOCTEST_SUBCASE("edit")
+        {
+            testedFunctionality = [rejected] (std::unique_ptr<libnetconf::client::Session>& session) {
+                auto errors = rejected([&] {
+                    session->editData(libnetconf::NmdaDatastore::Running, R"(<unknownLeaf xmlns="http://example.com">AHOJ</unknownLeaf>)", {.validateLocally = true});
+                });
+                REQUIRE(errors.size() == 1);
+                REQUIRE(errors[0].tag == "unknown-element");
+                REQUIRE(errors[0].path);
+
+                errors = rejected([&] {
+                    session->editData(libnetconf::NmdaDatastore::Running, R"(<interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+  <interface><name>eth0</name><enabled>maybe</enabled></interface>
+</interfaces>)", {.validateLocally = true});
+                });
+                REQUIRE(errors.size() == 1);
+                REQUIRE(errors[0].tag == "invalid-value");
+                REQUIRE(errors[0].path);
+                REQUIRE(errors[0].path->find("enabled") != std::string::npos);
+                REQUIRE(errors[0].message->find("maybe") != std::string::npos);
+
+                session->editData(libnetconf::NmdaDatastore::Running, R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)", {.validateLocally = true});
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<edit-data", "<myLeaf"};
+        }
+
+        DOCTEST_SUBCASE("deleting a leaf without a valid value")
+        {
+            std::string operation;
+            DOCTEST_SUBCASE("delete")
+            {
+                operation = "delete";
+            }
+            DOCTEST_SUBCASE("remove")
+            {
+                operation = "remove";
+            }
+
+            testedFunctionality = [operation] (std::unique_ptr<libnetconf::client::Session>& session) {
+                session->editConfig(libnetconf::Datastore::Running, libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::Set, libnetconf::EditErrorOpt::Stop,
+                        R"(<interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces" xmlns:nc="urn:ietf:params:xml:ns:netconf:base:1.0">
+  <interface><name>eth0</name><enabled nc:operation=")" + operation + R"("/></interface>
+</interfaces>)", {.validateLocally = true});
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<edit-config", "<enabled", "\"" + operation + "\""};
+        }
+
+        DOCTEST_SUBCASE("copy-config")
+        {
+            testedFunctionality = [rejected] (std::unique_ptr<libnetconf::client::Session>& session) {
+                // A complete configuration has to be valid as a whole, the interface's type is mandatory
+                auto errors = rejected([&] {
+                    session->copyConfigFromString(libnetconf::Datastore::Running, R"(<interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+  <interface><name>eth0</name></interface>
+</interfaces>)", {.validateLocally = true});
+                });
+                REQUIRE(errors[0].message);
+                REQUIRE(errors[0].message->find("type") != std::string::npos);
+
+                session->copyConfigFromString(libnetconf::Datastore::Running, R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)", {.validateLocally = true});
+                return std::nullopt;
+            };
+            expectedRpcContent = {"<copy-config", "<myLeaf"};
+        }
+
+        replyData = mock_server::OK_REPLY;
+    }
+
+    DOCTEST_SUBCASE("list cursor")
+    {
+        testedFunctionality = [] (std::unique_ptr<libnetconf::client::Session>& session) {
+            REQUIRE_THROWS_AS(session->listCursor(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces"), std::invalid_argument);
+            REQUIRE_THROWS_AS(session->listCursor(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces/interface", 0), std::invalid_argument);
+
+            // A short page is the last one, so there's just one round trip
+            auto cursor = session->listCursor(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces/interface", 3);
+            std::vector<std::string> names;
+            while (auto entry = cursor.next()) {
+                names.push_back(entry->findPath("name")->asTerm().valueStr());
+            }
+            REQUIRE(names == std::vector<std::string>{"eth0", "eth1"});
+            REQUIRE(!cursor.next());
+            return std::nullopt;
+        };
+
+        replyData = createNmdaDataReply(R"(<interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+  <interface><name>eth0</name></interface>
+  <interface><name>eth1</name></interface>
+</interfaces>)"s);
+        expectedRpcContent = {"<get-data", "ds:operational", "/ietf-interfaces:interfaces/interface[position() ", " and position() "};
+    }
+
     libnetconf::client::setLogLevel(libnetconf::LogLevel::Debug);
     libnetconf::client::setLogCallback(logCb);
     auto x = std::jthread{[&testedFunctionality, &expectedJSON, &processInput, &processOutput] {
         auto ctx = libyang::Context(std::nullopt,
                 libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
         auto session = libnetconf::client::Session::connectFd(processInput.pipe().native_source(), processOutput.pipe().native_sink(), ctx);
+        const auto& loaded = session->connectProfile().loadedModules;
+        REQUIRE(std::find_if(loaded.begin(), loaded.end(), [](const auto& mod) { return mod.name == "example-schema"; }) != loaded.end());
         auto dataNode = testedFunctionality(session);
         std::string actualJSON;
         if (dataNode) {
@@ -246,7 +495,7 @@ TEST_CASE("client")
 
     mock_server::handleSessionStart(curMsgId, processInput, processOutput);
 
-    mock_server::skipNetconfChunk(processOutput);
+    mock_server::skipNetconfChunk(processOutput, expectedRpcContent);
     mock_server::sendRpcReply(curMsgId, processInput, replyData);
 
     // For <close-session>
@@ -260,3 +509,292 @@ TEST_CASE("client")
         REQUIRE(logBuf.empty());
     }
 }
+
+TEST_CASE("transaction")
+{
+    boost::process::ipstream processOutput;
+    boost::process::opstream processInput;
+    int curMsgId = 1;
+    bool editSucceeds;
+
+    DOCTEST_SUBCASE("success")
+    {
+        editSucceeds = true;
+    }
+
+    DOCTEST_SUBCASE("edit fails")
+    {
+        editSucceeds = false;
+    }
+
+    auto x = std::jthread{[&editSucceeds, &processInput, &processOutput] {
+        auto ctx = libyang::Context(std::nullopt,
+                libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+        auto session = libnetconf::client::Session::connectFd(processInput.pipe().native_source(), processOutput.pipe().native_sink(), ctx);
+        auto transaction = session->transaction();
+        transaction.editConfig(libnetconf::EditDefaultOp::Merge,
+                               libnetconf::EditTestOpt::TestSet,
+                               libnetconf::EditErrorOpt::Rollback,
+                               R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)");
+        if (editSucceeds) {
+            transaction.commit();
+        } else {
+            REQUIRE_THROWS_AS(transaction.commit(), libnetconf::client::ReportedError);
+        }
+    }};
+
+    auto testFailureHandler = make_unique_resource([] {}, [&] {
+        if (std::uncaught_exceptions()) {
+            processInput.pipe().close();
+            processOutput.pipe().close();
+        }
+    });
+
+    mock_server::handleSessionStart(curMsgId, processInput, processOutput);
+
+    mock_server::skipNetconfChunk(processOutput, {"<lock", "<candidate/>"});
+    mock_server::sendRpcReply(curMsgId++, processInput, mock_server::OK_REPLY);
+
+    // The edits and the validation arrive before any of them is answered
+    mock_server::skipNetconfChunk(processOutput, {"<edit-config", "<candidate/>", "AHOJ"});
+    mock_server::skipNetconfChunk(processOutput, {"<validate", "<candidate/>"});
+    mock_server::sendRpcReply(curMsgId++, processInput, editSucceeds ? mock_server::OK_REPLY : R"(<rpc-error>
+  <error-type>application</error-type>
+  <error-tag>invalid-value</error-tag>
+  <error-severity>error</error-severity>
+</rpc-error>
+)");
+    mock_server::sendRpcReply(curMsgId++, processInput, mock_server::OK_REPLY);
+
+    if (editSucceeds) {
+        mock_server::skipNetconfChunk(processOutput, {"<commit"});
+    }
+    mock_server::skipNetconfChunk(processOutput, {"<discard-changes"});
+    mock_server::skipNetconfChunk(processOutput, {"<unlock", "<candidate/>"});
+    for (int i = 0; i < (editSucceeds ? 3 : 2); ++i) {
+        mock_server::sendRpcReply(curMsgId++, processInput, mock_server::OK_REPLY);
+    }
+
+    mock_server::skipNetconfChunk(processOutput, {"<close-session"});
+    mock_server::sendRpcReply(curMsgId, processInput, mock_server::OK_REPLY);
+}
+
+TEST_CASE("transaction which gives up")
+{
+    using namespace std::chrono_literals;
+    const mock_server::Rule slowEdit{.match = {"<edit-config"}, .reply = "<ok/>", .latency = 300ms};
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {.match = {"<lock"}, .reply = "<ok/>"},
+        slowEdit,
+        {.match = {"<validate"}, .reply = "<ok/>"},
+        {.match = {"<discard-changes"}, .reply = "<ok/>"},
+        {.match = {"<unlock"}, .reply = "<ok/>"},
+        {.match = {"<commit"}, .reply = "<ok/>"},
+    }};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto session = libnetconf::client::Session::connectFd(fd, fd,
+            libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs));
+
+    auto transaction = session->transaction();
+    transaction.editConfig(libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::Set, libnetconf::EditErrorOpt::Stop, R"(<myLeaf xmlns="http://example.com">1</myLeaf>)");
+    transaction.editConfig(libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::Set, libnetconf::EditErrorOpt::Stop, R"(<myLeaf xmlns="http://example.com">2</myLeaf>)");
+
+    std::stop_source stop;
+    libnetconf::client::CallOptions options;
+    DOCTEST_SUBCASE("deadline")
+    {
+        // The lock makes it in time, the edits do not
+        options.deadline = std::chrono::steady_clock::now() + 150ms;
+        REQUIRE_THROWS_AS(transaction.commit(options), libnetconf::client::TimedOut);
+    }
+
+    DOCTEST_SUBCASE("cancellation")
+    {
+        options.stopToken = stop.get_token();
+        std::jthread stopper{[&stop] {
+            std::this_thread::sleep_for(150ms);
+            stop.request_stop();
+        }};
+        REQUIRE_THROWS_AS(transaction.commit(options), libnetconf::client::Cancelled);
+    }
+
+    // The cleanup has waited for the edits and the validation, then discarded and unlocked, and nothing was committed
+    REQUIRE(server.answered(1) == 2);
+    REQUIRE(server.answered(2) == 1);
+    REQUIRE(server.answered(3) == 1);
+    REQUIRE(server.answered(4) == 1);
+    REQUIRE(server.answered(5) == 0);
+
+    // The session is still in sync with the server
+    session->lock(libnetconf::Datastore::Candidate);
+    REQUIRE(server.answered(0) == 2);
+}
+
+TEST_CASE("late replies of abandoned calls")
+{
+    using namespace std::string_literals;
+    boost::process::ipstream processOutput;
+    boost::process::opstream processInput;
+    int curMsgId = 1;
+    std::promise<void> abandoned;
+    std::stop_source stop;
+    bool byDeadline;
+
+    DOCTEST_SUBCASE("deadline")
+    {
+        byDeadline = true;
+    }
+
+    DOCTEST_SUBCASE("cancellation")
+    {
+        byDeadline = false;
+    }
+
+    auto x = std::jthread{[&] {
+        auto ctx = libyang::Context(std::nullopt,
+                libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+        auto session = libnetconf::client::Session::connectFd(processInput.pipe().native_source(), processOutput.pipe().native_sink(), ctx);
+        if (byDeadline) {
+            REQUIRE_THROWS_AS(session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, {.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{500}}),
+                              libnetconf::client::TimedOut);
+        } else {
+            REQUIRE_THROWS_AS(session->getData(libnetconf::NmdaDatastore::Running, std::nullopt, {.stopToken = stop.get_token()}),
+                              libnetconf::client::Cancelled);
+        }
+        abandoned.set_value();
+
+        // The reply to the first call arrives in the meantime, and must not be taken for the reply to this one
+        auto data = session->getData(libnetconf::NmdaDatastore::Running);
+        REQUIRE(data);
+        REQUIRE(data->asTerm().valueStr() == "AHOJ");
+    }};
+
+    auto testFailureHandler = make_unique_resource([] {}, [&] {
+        if (std::uncaught_exceptions()) {
+            processInput.pipe().close();
+            processOutput.pipe().close();
+        }
+    });
+
+    mock_server::handleSessionStart(curMsgId, processInput, processOutput);
+
+    mock_server::skipNetconfChunk(processOutput, {"<get-data"});
+    if (!byDeadline) {
+        stop.request_stop();
+    }
+    abandoned.get_future().wait();
+
+    mock_server::skipNetconfChunk(processOutput, {"<get-data"});
+    mock_server::sendRpcReply(curMsgId++, processInput, createNmdaDataReply(R"(<myLeaf xmlns="http://example.com">LATE</myLeaf>)"s));
+    mock_server::sendRpcReply(curMsgId++, processInput, createNmdaDataReply(R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)"s));
+
+    mock_server::skipNetconfChunk(processOutput, {"<close-session"});
+    mock_server::sendRpcReply(curMsgId, processInput, mock_server::OK_REPLY);
+}
+
+TEST_CASE("retries")
+{
+    using namespace std::chrono_literals;
+    using libnetconf::client::RetryPolicy;
+
+    auto lockDenied = mock_server::Rule{.match = {"<lock"}, .reply = mock_server::rpcError("lock-denied")};
+    std::vector<mock_server::Rule> rules;
+    libnetconf::client::CallOptions options;
+    std::stop_source stop;
+    unsigned minAttempts, maxAttempts;
+    bool succeeds = false;
+    bool cancelled = false;
+    auto maxDuration = 5s;
+
+    DOCTEST_SUBCASE("transient errors")
+    {
+        lockDenied.times = 2;
+        rules = {lockDenied, {.match = {"<lock"}, .reply = mock_server::OK_REPLY}};
+        options.retry = RetryPolicy{.initialBackoff = 1ms, .jitter = 0};
+        minAttempts = maxAttempts = 2;
+        succeeds = true;
+    }
+
+    DOCTEST_SUBCASE("no retry policy")
+    {
+        rules = {lockDenied};
+        minAttempts = maxAttempts = 1;
+    }
+
+    DOCTEST_SUBCASE("attempts are limited")
+    {
+        rules = {lockDenied};
+        options.retry = RetryPolicy{.maxAttempts = 3, .initialBackoff = 1ms, .jitter = 0};
+        minAttempts = maxAttempts = 3;
+    }
+
+    DOCTEST_SUBCASE("tags which are not retried")
+    {
+        rules = {{.match = {"<lock"}, .reply = mock_server::rpcError("access-denied")}};
+        options.retry = RetryPolicy{.initialBackoff = 1ms, .jitter = 0};
+        minAttempts = maxAttempts = 1;
+    }
+
+    DOCTEST_SUBCASE("backoff is capped")
+    {
+        // Without the cap, the second pause alone would take 5 seconds
+        rules = {lockDenied};
+        options.retry = RetryPolicy{.maxAttempts = 4, .initialBackoff = 50ms, .maxBackoff = 60ms, .multiplier = 100, .jitter = 0};
+        minAttempts = maxAttempts = 4;
+        maxDuration = 2s;
+    }
+
+    DOCTEST_SUBCASE("overall timeout")
+    {
+        // Attempts start at roughly 0, 100, 200 and 300 ms, unless the round trips take long
+        rules = {lockDenied};
+        options.retry = RetryPolicy{.maxAttempts = 100, .initialBackoff = 100ms, .multiplier = 1, .jitter = 0, .overallTimeout = 350ms};
+        minAttempts = 2;
+        maxAttempts = 4;
+        maxDuration = 2s;
+    }
+
+    DOCTEST_SUBCASE("stop during backoff")
+    {
+        rules = {lockDenied};
+        options.retry = RetryPolicy{.initialBackoff = 1h, .jitter = 0};
+        options.stopToken = stop.get_token();
+        minAttempts = maxAttempts = 1;
+        cancelled = true;
+    }
+
+    mock_server::Server server{TESTS_DIR "/modules", rules};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto session = libnetconf::client::Session::connectFd(fd, fd,
+            libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs));
+
+    std::jthread stopper;
+    if (cancelled) {
+        stopper = std::jthread{[&stop, &server](std::stop_token giveUp) {
+            while (!giveUp.stop_requested() && !server.answered(0)) {
+                std::this_thread::sleep_for(10ms);
+            }
+            // By now, the client waits for the next attempt
+            std::this_thread::sleep_for(100ms);
+            stop.request_stop();
+        }};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (succeeds) {
+        session->lock(libnetconf::Datastore::Running, options);
+    } else if (cancelled) {
+        REQUIRE_THROWS_AS(session->lock(libnetconf::Datastore::Running, options), libnetconf::client::Cancelled);
+    } else {
+        REQUIRE_THROWS_AS(session->lock(libnetconf::Datastore::Running, options), libnetconf::client::ReportedError);
+    }
+    REQUIRE(std::chrono::steady_clock::now() - start < maxDuration);
+
+    REQUIRE(server.answered(0) >= minAttempts);
+    REQUIRE(server.answered(0) <= maxAttempts);
+    if (succeeds) {
+        REQUIRE(server.answered(1) == 1);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <cmath>
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/columns.hpp>
+#include "test_vars.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("columns")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("ietf-interfaces");
+
+    libnetconf::client::ColumnExtractor extractor{ctx, "/ietf-interfaces:interfaces/interface", {"statistics/in-octets", "statistics/out-octets"}};
+
+    auto sample = [&ctx](const std::vector<std::tuple<std::string, uint64_t, std::optional<uint64_t>>>& interfaces) {
+        std::optional<libyang::DataNode> tree;
+        for (const auto& [name, in, out] : interfaces) {
+            auto prefix = "/ietf-interfaces:interfaces/interface[name='" + name + "']/statistics/";
+            if (tree) {
+                tree->newPath(prefix + "in-octets", std::to_string(in));
+            } else {
+                tree = ctx.newPath(prefix + "in-octets", std::to_string(in));
+            }
+            if (out) {
+                tree->newPath(prefix + "out-octets", std::to_string(*out));
+            }
+        }
+        return *tree;
+    };
+
+    auto first = extractor.extract(sample({{"eth0", 100, 10}, {"eth1", 200, std::nullopt}}));
+    REQUIRE(first.keys == std::vector<std::string>{"eth0", "eth1"});
+    REQUIRE(first.columns.size() == 2);
+    REQUIRE(first.columns[0].path == "statistics/in-octets");
+    REQUIRE(first.columns[0].type == libyang::LeafBaseType::Uint64);
+    REQUIRE(std::get<std::vector<uint64_t>>(first.columns[0].values) == std::vector<uint64_t>{100, 200});
+    REQUIRE(std::get<std::vector<uint64_t>>(first.columns[1].values) == std::vector<uint64_t>{10, 0});
+    REQUIRE(first.columns[1].present == std::vector<uint8_t>{1, 0});
+
+    DOCTEST_SUBCASE("same rows")
+    {
+        auto second = extractor.extract(sample({{"eth0", 300, 20}, {"eth1", 1200, 5}}));
+        auto rates = libnetconf::client::counterRates(first, second, 0, 2s);
+        REQUIRE(rates == std::vector<double>{100, 500});
+        rates = libnetconf::client::counterRates(first, second, 1, 2s);
+        REQUIRE(rates[0] == 5);
+        REQUIRE(std::isnan(rates[1]));
+    }
+
+    DOCTEST_SUBCASE("rows come and go")
+    {
+        auto second = extractor.extract(sample({{"eth1", 400, std::nullopt}, {"eth2", 1, std::nullopt}}));
+        auto rates = libnetconf::client::counterRates(first, second, 0, 1s);
+        REQUIRE(rates.size() == 2);
+        REQUIRE(rates[0] == 200);
+        REQUIRE(std::isnan(rates[1]));
+    }
+
+    DOCTEST_SUBCASE("counters wrap around")
+    {
+        libnetconf::client::ColumnExtractor wrapping{ctx, "/ietf-interfaces:interfaces/interface", {"statistics/in-octets", "statistics/in-discards"}};
+        auto counters = [&ctx](const std::string& octets, const std::string& discards) {
+            auto tree = ctx.newPath("/ietf-interfaces:interfaces/interface[name='eth0']/statistics/in-octets", octets);
+            tree.newPath("/ietf-interfaces:interfaces/interface[name='eth0']/statistics/in-discards", discards);
+            return tree;
+        };
+
+        auto before = wrapping.extract(counters("18446744073709551516", "4294967286"));
+        auto after = wrapping.extract(counters("100", "10"));
+        REQUIRE(before.columns[1].type == libyang::LeafBaseType::Uint32);
+        // The counter64 has wrapped modulo 2^64, the counter32 modulo 2^32
+        REQUIRE(libnetconf::client::counterRates(before, after, 0, 2s) == std::vector<double>{100});
+        REQUIRE(libnetconf::client::counterRates(before, after, 1, 2s) == std::vector<double>{10});
+    }
+
+    DOCTEST_SUBCASE("signed and decimal64 columns")
+    {
+        ctx.loadModule("example-statistics");
+        libnetconf::client::ColumnExtractor sensors{ctx, "/example-statistics:sensors/sensor", {"offset", "temperature"}};
+        auto tree = ctx.newPath("/example-statistics:sensors/sensor[name='inlet']/offset", "-5");
+        tree.newPath("/example-statistics:sensors/sensor[name='inlet']/temperature", "21.50");
+        tree.newPath("/example-statistics:sensors/sensor[name='outlet']/temperature", "-3.25");
+
+        auto columns = sensors.extract(tree);
+        REQUIRE(columns.keys == std::vector<std::string>{"inlet", "outlet"});
+        REQUIRE(columns.columns[0].type == libyang::LeafBaseType::Int32);
+        REQUIRE(std::get<std::vector<int64_t>>(columns.columns[0].values) == std::vector<int64_t>{-5, 0});
+        REQUIRE(columns.columns[0].present == std::vector<uint8_t>{1, 0});
+        REQUIRE(columns.columns[1].type == libyang::LeafBaseType::Dec64);
+        REQUIRE(std::get<std::vector<double>>(columns.columns[1].values) == std::vector<double>{21.5, -3.25});
+        REQUIRE(columns.columns[1].present == std::vector<uint8_t>{1, 1});
+
+        REQUIRE_THROWS_AS(libnetconf::client::counterRates(columns, columns, 0, 1s), std::invalid_argument);
+        REQUIRE_THROWS_AS(libnetconf::client::counterRates(columns, columns, 1, 1s), std::invalid_argument);
+    }
+
+    DOCTEST_SUBCASE("invalid paths")
+    {
+        REQUIRE_THROWS_AS(libnetconf::client::ColumnExtractor(ctx, "/ietf-interfaces:interfaces/interface", {"description"}), std::invalid_argument);
+        REQUIRE_THROWS_AS(libnetconf::client::ColumnExtractor(ctx, "/ietf-interfaces:interfaces", {"interface/statistics/in-octets"}), std::invalid_argument);
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/compiled-path.hpp>
+#include "test_vars.hpp"
+
+TEST_CASE("compiled path")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+    ctx.loadModule("ietf-interfaces");
+
+    DOCTEST_SUBCASE("leaf")
+    {
+        libnetconf::client::CompiledPath path{ctx, "/example-schema:myLeaf"};
+        auto tree = ctx.newPath("/ietf-interfaces:interfaces/interface[name='eth0']");
+        REQUIRE(!path.find(tree));
+
+        tree.newPath("/example-schema:myLeaf", "AHOJ");
+        auto found = path.find(tree);
+        REQUIRE(found);
+        REQUIRE(found->path() == "/example-schema:myLeaf");
+        REQUIRE(found->asTerm().valueStr() == "AHOJ");
+    }
+
+    DOCTEST_SUBCASE("list instances")
+    {
+        libnetconf::client::CompiledPath path{ctx, "/ietf-interfaces:interfaces/interface"};
+        auto tree = ctx.newPath("/ietf-interfaces:interfaces/interface[name='eth0']");
+        tree.newPath("/ietf-interfaces:interfaces/interface[name='eth1']");
+        tree.newPath("/example-schema:myLeaf", "AHOJ");
+
+        REQUIRE(path.find(tree)->path() == "/ietf-interfaces:interfaces/interface[name='eth0']");
+        auto all = path.findAll(tree);
+        REQUIRE(all.size() == 2);
+        REQUIRE(all[1].path() == "/ietf-interfaces:interfaces/interface[name='eth1']");
+    }
+
+    DOCTEST_SUBCASE("invalid paths")
+    {
+        REQUIRE_THROWS_AS(libnetconf::client::CompiledPath(ctx, "/example-schema:nonexistent"), std::invalid_argument);
+        REQUIRE_THROWS_AS(libnetconf::client::CompiledPath(ctx, "/ietf-interfaces:interfaces/interface/name"), std::invalid_argument);
+    }
+}
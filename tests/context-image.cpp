@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/context-image.hpp>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+TEST_CASE("context image")
+{
+    auto path = std::filesystem::temp_directory_path() / ("libnetconf2-cpp-context-" + std::to_string(::getpid()) + ".img");
+    auto removeImage = make_unique_resource([] {}, [&path] { std::filesystem::remove(path); });
+
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+    ctx.loadModule("ietf-interfaces");
+
+    if (!libnetconf::client::contextImagesSupported()) {
+        REQUIRE_THROWS_AS(libnetconf::client::printContextImage(ctx, path), std::logic_error);
+        REQUIRE_THROWS_AS(libnetconf::client::mapContextImage(path), std::logic_error);
+        return;
+    }
+
+    libnetconf::client::printContextImage(ctx, path);
+
+    {
+        auto mapped = libnetconf::client::mapContextImage(path);
+        REQUIRE(mapped.getModule("example-schema", std::nullopt));
+        REQUIRE(mapped.findPath("/ietf-interfaces:interfaces/interface/name").nodeType() == libyang::NodeType::Leaf);
+
+        auto data = mapped.parseData(R"({"example-schema:myLeaf": "AHOJ"})", libyang::DataFormat::JSON);
+        REQUIRE(data);
+        REQUIRE(data->asTerm().valueStr() == "AHOJ");
+
+        // The address is already taken by the mapping above
+        REQUIRE_THROWS_AS(libnetconf::client::mapContextImage(path), std::system_error);
+
+        // An image at another path, e.g., for another device family, gets its own address
+        auto otherPath = std::filesystem::temp_directory_path() / ("libnetconf2-cpp-context-other-" + std::to_string(::getpid()) + ".img");
+        while (libnetconf::client::contextImageAddress(otherPath) == libnetconf::client::contextImageAddress(path)) {
+            otherPath += "_";
+        }
+        auto removeOther = make_unique_resource([] {}, [&otherPath] { std::filesystem::remove(otherPath); });
+        libnetconf::client::printContextImage(ctx, otherPath);
+        auto other = libnetconf::client::mapContextImage(otherPath);
+        REQUIRE(other.getModule("ietf-interfaces", std::nullopt));
+        REQUIRE(mapped.getModule("ietf-interfaces", std::nullopt));
+    }
+
+    // Once the context is gone, so is its mapping
+    auto again = libnetconf::client::mapContextImage(path);
+    REQUIRE(again.getModule("ietf-interfaces", std::nullopt));
+
+    std::filesystem::resize_file(path, 100);
+    REQUIRE_THROWS_WITH(libnetconf::client::mapContextImage(path), doctest::Contains("is not a context image"));
+}
+
+TEST_CASE("session with a context image")
+{
+    if (!libnetconf::client::contextImagesSupported()) {
+        return;
+    }
+
+    auto path = std::filesystem::temp_directory_path() / ("libnetconf2-cpp-session-context-" + std::to_string(::getpid()) + ".img");
+    auto removeImage = make_unique_resource([] {}, [&path] { std::filesystem::remove(path); });
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {
+            .match = {"<get-data", "ds:running"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)",
+        },
+    }};
+
+    {
+        // This context has everything that the server announces
+        auto fd = server.connect();
+        auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+        auto session = libnetconf::client::Session::connectFd(fd, fd, std::nullopt);
+        libnetconf::client::printContextImage(session->libyangContext(), path);
+    }
+
+    auto ctx = libnetconf::client::mapContextImage(path);
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto session = libnetconf::client::Session::connectFd(fd, fd, ctx);
+    // No module had to be fetched or loaded
+    REQUIRE(session->connectProfile().loadedModules.empty());
+
+    auto data = session->getData(libnetconf::NmdaDatastore::Running);
+    REQUIRE(data);
+    REQUIRE(data->path() == "/example-schema:myLeaf");
+    REQUIRE(data->asTerm().valueStr() == "AHOJ");
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/diff.hpp>
+#include <libyang-cpp/Context.hpp>
+#include "test_vars.hpp"
+
+TEST_CASE("diff")
+{
+    using libnetconf::client::Change;
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("ietf-interfaces");
+    ctx.loadModule("example-schema");
+
+    auto tree = [&ctx](const std::vector<std::pair<std::string, std::string>>& leaves) {
+        std::optional<libyang::DataNode> res;
+        for (const auto& [path, value] : leaves) {
+            if (res) {
+                res->newPath(path, value);
+            } else {
+                res = ctx.newPath(path, value);
+            }
+        }
+        return res;
+    };
+
+    const std::string eth0 = "/ietf-interfaces:interfaces/interface[name='eth0']";
+    const std::string eth1 = "/ietf-interfaces:interfaces/interface[name='eth1']";
+    const std::string eth2 = "/ietf-interfaces:interfaces/interface[name='eth2']";
+    auto before = tree({
+        {eth0 + "/description", "uplink"},
+        {eth0 + "/enabled", "false"},
+        {eth1 + "/description", "spare"},
+        {"/example-schema:myLeaf", "old"},
+    });
+
+    DOCTEST_SUBCASE("identical")
+    {
+        REQUIRE(libnetconf::client::diff(before, before).empty());
+        REQUIRE(libnetconf::client::diff(std::nullopt, std::nullopt).empty());
+    }
+
+    DOCTEST_SUBCASE("changes")
+    {
+        // Same content in a different order of list entries
+        auto after = tree({
+            {eth2 + "/description", "new"},
+            {eth0 + "/enabled", "true"},
+            {eth0 + "/description", "uplink"},
+        });
+        REQUIRE(libnetconf::client::diff(before, after) == std::vector<Change>{
+                    {Change::Type::Modified, eth0 + "/enabled", "false", "true"},
+                    {Change::Type::Deleted, eth1, std::nullopt, std::nullopt},
+                    {Change::Type::Created, eth2, std::nullopt, std::nullopt},
+                    {Change::Type::Deleted, "/example-schema:myLeaf", "old", std::nullopt},
+                });
+    }
+
+    DOCTEST_SUBCASE("from scratch")
+    {
+        REQUIRE(libnetconf::client::diff(std::nullopt, before) == std::vector<Change>{
+                    {Change::Type::Created, "/ietf-interfaces:interfaces", std::nullopt, std::nullopt},
+                    {Change::Type::Created, "/example-schema:myLeaf", std::nullopt, "old"},
+                });
+    }
+
+    DOCTEST_SUBCASE("subtree")
+    {
+        auto after = tree({
+            {eth0 + "/description", "downlink"},
+            {eth0 + "/enabled", "false"},
+            {"/example-schema:myLeaf", "new"},
+        });
+        REQUIRE(libnetconf::client::diff(before, after, eth0) == std::vector<Change>{
+                    {Change::Type::Modified, eth0 + "/description", "uplink", "downlink"},
+                });
+        REQUIRE(libnetconf::client::diff(before, after, eth1) == std::vector<Change>{
+                    {Change::Type::Deleted, eth1, std::nullopt, std::nullopt},
+                });
+        REQUIRE(libnetconf::client::diff(before, after, "/example-schema:myLeaf") == std::vector<Change>{
+                    {Change::Type::Modified, "/example-schema:myLeaf", "old", "new"},
+                });
+    }
+}
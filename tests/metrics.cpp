@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/metrics.hpp>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+using namespace std::chrono_literals;
+using libnetconf::client::Metrics;
+
+TEST_CASE("metrics")
+{
+    Metrics metrics;
+
+    metrics.sessionOpened();
+    metrics.sessionOpened();
+    metrics.sessionClosed();
+    metrics.connectFinished(20ms, true);
+    metrics.connectFinished(5ms, false);
+    metrics.rpcFinished(Metrics::Operation::GetData, Metrics::Outcome::Ok, 300us);
+    metrics.rpcFinished(Metrics::Operation::GetData, Metrics::Outcome::Ok, 40ms);
+    metrics.rpcFinished(Metrics::Operation::EditConfig, Metrics::Outcome::RpcError, 2ms);
+    metrics.rpcFinished(Metrics::Operation::Commit, Metrics::Outcome::Failed, 20s);
+    metrics.rpcErrorReported("lock-denied");
+    metrics.rpcErrorReported("lock-denied");
+    metrics.rpcErrorReported("something-nonstandard");
+    metrics.notificationReceived();
+    metrics.bytesReceived(1000);
+    metrics.bytesReceived(234);
+
+    const auto text = metrics.render();
+
+    DOCTEST_SUBCASE("sessions")
+    {
+        REQUIRE(text.find("\nnetconf_client_sessions_opened_total 2\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_sessions_active 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_connect_failures_total 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_connect_duration_seconds_sum 0.025\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_connect_duration_seconds_count 2\n") != std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("RPCs")
+    {
+        REQUIRE(text.find("\nnetconf_client_rpcs_total{operation=\"get-data\",outcome=\"ok\"} 2\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpcs_total{operation=\"edit-config\",outcome=\"rpc-error\"} 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpcs_total{operation=\"commit\",outcome=\"failed\"} 1\n") != std::string::npos);
+        REQUIRE(text.find("operation=\"get\"") == std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("latency histogram")
+    {
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_bucket{le=\"0.0005\"} 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_bucket{le=\"0.0025\"} 2\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_bucket{le=\"0.05\"} 3\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_bucket{le=\"10\"} 3\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_bucket{le=\"+Inf\"} 4\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_duration_seconds_count 4\n") != std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("errors and notifications")
+    {
+        REQUIRE(text.find("\nnetconf_client_rpc_errors_total{tag=\"lock-denied\"} 2\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_rpc_errors_total{tag=\"other\"} 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_notifications_total 1\n") != std::string::npos);
+        REQUIRE(text.find("\nnetconf_client_received_bytes_total 1234\n") != std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("rendering to a file descriptor")
+    {
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+        metrics.renderTo(fds[1]);
+        close(fds[1]);
+        std::string read;
+        char buf[4096];
+        ssize_t len;
+        while ((len = ::read(fds[0], buf, sizeof(buf))) > 0) {
+            read.append(buf, len);
+        }
+        close(fds[0]);
+        REQUIRE(read == text);
+    }
+}
+
+TEST_CASE("metrics of sessions")
+{
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {
+            .match = {"<get-data"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)",
+            .notifications = 2,
+            .notification = R"(<netconf-config-change xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-notifications"/>)",
+        },
+    }};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto ctx = libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+
+    Metrics metrics;
+    libnetconf::client::setMetrics(&metrics);
+    auto uninstall = make_unique_resource([] {}, [] { libnetconf::client::setMetrics(nullptr); });
+    auto has = [&metrics](const std::string& line) {
+        return metrics.render().find('\n' + line + '\n') != std::string::npos;
+    };
+    auto value = [&metrics](const std::string& name) {
+        const auto text = metrics.render();
+        auto pos = text.find('\n' + name + ' ');
+        REQUIRE(pos != std::string::npos);
+        return std::stoull(text.substr(pos + name.size() + 2));
+    };
+
+    auto session = libnetconf::client::Session::connectFd(fd, fd, ctx, libnetconf::client::ConnectProfiling::Detailed);
+    REQUIRE(has("netconf_client_sessions_opened_total 1"));
+    REQUIRE(has("netconf_client_sessions_active 1"));
+    REQUIRE(has("netconf_client_connect_duration_seconds_count 1"));
+    REQUIRE(has("netconf_client_connect_failures_total 0"));
+
+    REQUIRE(session->getData(libnetconf::NmdaDatastore::Running));
+    REQUIRE_THROWS_AS(session->discard(), libnetconf::client::ReportedError);
+    REQUIRE(has("netconf_client_rpcs_total{operation=\"get-data\",outcome=\"ok\"} 1"));
+    REQUIRE(has("netconf_client_rpcs_total{operation=\"discard-changes\",outcome=\"rpc-error\"} 1"));
+    REQUIRE(has("netconf_client_rpc_errors_total{tag=\"operation-not-supported\"} 1"));
+    REQUIRE(has("netconf_client_notifications_total 2"));
+    REQUIRE(has("netconf_client_rpc_duration_seconds_count 2"));
+    // Everything up to the last reply, including the connect
+    const auto received = value("netconf_client_received_bytes_total");
+    REQUIRE(received > session->connectProfile().bytesReceived);
+
+    // The session reports its closing to the registry which has seen it open, not to whichever one is installed now
+    Metrics other;
+    libnetconf::client::setMetrics(&other);
+    session.reset();
+    REQUIRE(has("netconf_client_sessions_active 0"));
+    REQUIRE(value("netconf_client_received_bytes_total") >= received);
+    REQUIRE(other.render().find("\nnetconf_client_sessions_opened_total 0\n") != std::string::npos);
+    REQUIRE(other.render().find("\nnetconf_client_sessions_active 0\n") != std::string::npos);
+}
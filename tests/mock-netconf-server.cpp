@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libyang-cpp/Context.hpp>
+#include <thread>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+libyang::Context emptyContext()
+{
+    return libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+}
+}
+
+TEST_CASE("mock NETCONF server")
+{
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {
+            .match = {"<get-data", "ds:running"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)",
+            .latency = 1ms,
+        },
+        {
+            .match = {"<get-data", "ds:operational"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda">)" + mock_server::syntheticInterfaces(100) + "</data>",
+            .notifications = 3,
+            .notification = R"(<netconf-config-change xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-notifications"/>)",
+        },
+    }};
+
+    auto exercise = [](libnetconf::client::Session& session) {
+        for (int i = 0; i < 3; ++i) {
+            auto data = session.getData(libnetconf::NmdaDatastore::Running);
+            REQUIRE(data);
+            REQUIRE(data->path() == "/example-schema:myLeaf");
+            REQUIRE(data->asTerm().valueStr() == "AHOJ");
+        }
+        auto interfaces = session.getData(libnetconf::NmdaDatastore::Operational);
+        REQUIRE(interfaces);
+        REQUIRE(interfaces->findXPath("/ietf-interfaces:interfaces/interface").size() == 100);
+        REQUIRE_THROWS_AS(session.discard(), libnetconf::client::ReportedError);
+    };
+
+    DOCTEST_SUBCASE("concurrent sessions on socketpairs")
+    {
+        std::vector<std::jthread> clients;
+        for (int i = 0; i < 4; ++i) {
+            clients.emplace_back([&server, &exercise] {
+                auto fd = server.connect();
+                auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+                auto session = libnetconf::client::Session::connectFd(fd, fd, emptyContext());
+                exercise(*session);
+            });
+        }
+        clients.clear();
+        REQUIRE(server.sessions() == 4);
+    }
+
+    DOCTEST_SUBCASE("Unix socket")
+    {
+        auto path = std::filesystem::temp_directory_path() / ("libnetconf2-cpp-mock-" + std::to_string(::getpid()) + ".sock");
+        server.listen(path);
+        auto session = libnetconf::client::Session::connectSocket(path, emptyContext());
+        exercise(*session);
+        REQUIRE(server.sessions() == 1);
+    }
+}
+
+TEST_CASE("connect profile")
+{
+    using libnetconf::client::ConnectProfiling;
+    mock_server::Server server{TESTS_DIR "/modules", {}};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+
+    auto loaded = [](const libnetconf::client::ConnectProfile& profile, const std::string& name) {
+        return std::any_of(profile.loadedModules.begin(), profile.loadedModules.end(), [&name](const auto& mod) { return mod.name == name; });
+    };
+
+    DOCTEST_SUBCASE("summary")
+    {
+        auto session = libnetconf::client::Session::connectFd(fd, fd, emptyContext());
+        const auto& profile = session->connectProfile();
+        REQUIRE(loaded(profile, "example-schema"));
+        REQUIRE(!profile.phases);
+        REQUIRE(profile.fetches.empty());
+        REQUIRE(profile.bytesReceived == 0);
+    }
+
+    DOCTEST_SUBCASE("detailed")
+    {
+        auto session = libnetconf::client::Session::connectFd(fd, fd, emptyContext(), ConnectProfiling::Detailed);
+        const auto& profile = session->connectProfile();
+        REQUIRE(profile.phases);
+        REQUIRE(profile.phases->hello > 0us);
+        REQUIRE(profile.phases->moduleDiscovery > 0us);
+        REQUIRE(profile.phases->hello + profile.phases->moduleDiscovery + profile.phases->moduleFetch + profile.phases->local == profile.sessionSetup);
+
+        auto schema = std::find_if(profile.fetches.begin(), profile.fetches.end(), [](const auto& fetch) { return fetch.module == "example-schema"; });
+        REQUIRE(schema != profile.fetches.end());
+        REQUIRE(schema->bytes > 0);
+        std::chrono::microseconds fetching{0};
+        uint64_t fetched = 0;
+        for (const auto& fetch : profile.fetches) {
+            fetching += fetch.duration;
+            fetched += fetch.bytes;
+        }
+        REQUIRE(profile.phases->moduleFetch == fetching);
+        REQUIRE(profile.bytesReceived > fetched);
+        REQUIRE(profile.bytesSent > 0);
+
+        // The session keeps working through the relay
+        REQUIRE_THROWS_AS(session->discard(), libnetconf::client::ReportedError);
+    }
+
+    DOCTEST_SUBCASE("Unix socket")
+    {
+        auto path = std::filesystem::temp_directory_path() / ("libnetconf2-cpp-mock-profile-" + std::to_string(::getpid()) + ".sock");
+        server.listen(path);
+        auto session = libnetconf::client::Session::connectSocket(path, emptyContext(), ConnectProfiling::Detailed);
+        REQUIRE(session->connectProfile().phases);
+        REQUIRE(!session->connectProfile().fetches.empty());
+        REQUIRE_THROWS_AS(session->discard(), libnetconf::client::ReportedError);
+    }
+
+    DOCTEST_SUBCASE("without a context")
+    {
+        auto session = libnetconf::client::Session::connectFd(fd, fd, std::nullopt);
+        const auto& profile = session->connectProfile();
+        REQUIRE(loaded(profile, "example-schema"));
+        // These come with each new context
+        REQUIRE(!loaded(profile, "yang"));
+        REQUIRE(!loaded(profile, "ietf-yang-metadata"));
+        REQUIRE(!loaded(profile, "ietf-inet-types"));
+    }
+}
+
+TEST_CASE("list cursor in pages")
+{
+    auto page = [](const std::vector<std::string>& names) {
+        std::string res = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">)";
+        for (const auto& name : names) {
+            res += "<interface><name>" + name + "</name></interface>";
+        }
+        return res + "</interfaces></data>";
+    };
+    // Each page is requested exactly once, by the positions which follow the previous page. The comparison operators
+    // are escaped within the XML, so the rules only look at the bounds.
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {.match = {"<get-data", "[position() ", " 0 and position() ", " 2]"}, .reply = page({"eth0", "eth1"}), .times = 1},
+        {.match = {"<get-data", "[position() ", " 2 and position() ", " 4]"}, .reply = page({"eth2", "eth3"}), .times = 1},
+        {.match = {"<get-data", "[position() ", " 4 and position() ", " 6]"}, .reply = page({"eth4"}), .times = 1},
+    }};
+    auto fd = server.connect();
+    auto closeFd = make_unique_resource([] {}, [fd] { ::close(fd); });
+    auto session = libnetconf::client::Session::connectFd(fd, fd, emptyContext());
+
+    auto cursor = session->listCursor(libnetconf::NmdaDatastore::Operational, "/ietf-interfaces:interfaces/interface", 2);
+    std::vector<std::string> names;
+    while (auto entry = cursor.next()) {
+        names.push_back(entry->findPath("name")->asTerm().valueStr());
+    }
+    REQUIRE(names == std::vector<std::string>{"eth0", "eth1", "eth2", "eth3", "eth4"});
+    REQUIRE(!cursor.next());
+    for (size_t rule = 0; rule < 3; ++rule) {
+        REQUIRE(server.answered(rule) == 1);
+    }
+}
+
+TEST_CASE("synthetic datastore size")
+{
+    auto count = mock_server::syntheticInterfacesFor(1'000'000);
+    auto size = mock_server::syntheticInterfaces(count).size();
+    REQUIRE(size > 900'000);
+    REQUIRE(size < 1'100'000);
+}
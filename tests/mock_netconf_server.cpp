@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+#include "mock_netconf_server.hpp"
+
+using namespace std::string_literals;
+
+namespace mock_server {
+
+namespace {
+/** @short Buffered reading and writing of NETCONF messages on a socket */
+class Connection {
+public:
+    explicit Connection(const int fd)
+        : m_fd(fd)
+    {
+    }
+
+    /** @short Reads a message which ends with the NETCONF 1.0 end-of-message marker, i.e., the client's <hello> */
+    std::optional<std::string> readHello()
+    {
+        constexpr std::string_view marker = "]]>]]>";
+        std::size_t pos;
+        while ((pos = m_buf.find(marker)) == std::string::npos) {
+            if (!fill()) {
+                return std::nullopt;
+            }
+        }
+        auto res = m_buf.substr(0, pos);
+        m_buf.erase(0, pos + marker.size());
+        return res;
+    }
+
+    /** @short Reads a message with the chunked framing of NETCONF 1.1 */
+    std::optional<std::string> readChunked()
+    {
+        std::string msg;
+        std::size_t pos = 0;
+        while (true) {
+            // "\n#" followed by either the chunk size and "\n", or "#\n" at the end of the message
+            std::size_t eol;
+            while ((eol = m_buf.find('\n', pos + 1)) == std::string::npos) {
+                if (!fill()) {
+                    return std::nullopt;
+                }
+            }
+            if (m_buf.compare(pos, 2, "\n#") != 0) {
+                return std::nullopt;
+            }
+            if (m_buf.compare(pos + 2, 2, "#\n") == 0) {
+                m_buf.erase(0, pos + 4);
+                return msg;
+            }
+            std::size_t size;
+            if (std::from_chars(m_buf.data() + pos + 2, m_buf.data() + eol, size).ec != std::errc{}) {
+                return std::nullopt;
+            }
+            while (m_buf.size() < eol + 1 + size) {
+                if (!fill()) {
+                    return std::nullopt;
+                }
+            }
+            msg.append(m_buf, eol + 1, size);
+            pos = eol + 1 + size;
+        }
+    }
+
+    bool write(std::string_view data)
+    {
+        while (!data.empty()) {
+            auto n = ::send(m_fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            data.remove_prefix(n);
+        }
+        return true;
+    }
+
+    bool writeChunked(const std::string& msg)
+    {
+        return write("\n#" + std::to_string(msg.size()) + "\n") && write(msg) && write("\n##\n");
+    }
+
+private:
+    bool fill()
+    {
+        char tmp[65536];
+        ssize_t n;
+        do {
+            n = ::read(m_fd, tmp, sizeof(tmp));
+        } while (n == -1 && errno == EINTR);
+        if (n <= 0) {
+            return false;
+        }
+        m_buf.append(tmp, n);
+        return true;
+    }
+
+    int m_fd;
+    std::string m_buf;
+};
+
+std::optional<std::string> element(const std::string& msg, const std::string& name)
+{
+    auto start = msg.find("<" + name + ">");
+    if (start == std::string::npos) {
+        return std::nullopt;
+    }
+    start += name.size() + 2;
+    auto end = msg.find("</" + name + ">", start);
+    if (end == std::string::npos) {
+        return std::nullopt;
+    }
+    return msg.substr(start, end - start);
+}
+
+std::string messageId(const std::string& msg)
+{
+    constexpr std::string_view attr = "message-id=\"";
+    auto start = msg.find(attr);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += attr.size();
+    return msg.substr(start, msg.find('"', start) - start);
+}
+
+std::string rpcReply(const std::string& msgId, const std::string& data)
+{
+    return R"(<rpc-reply xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id=")" + msgId + R"(">)" + data + "</rpc-reply>";
+}
+
+}
+
+/** @short The content of an <rpc-reply> which reports an error with @p tag */
+std::string rpcError(const std::string& tag)
+{
+    return "<rpc-error><error-type>protocol</error-type><error-tag>" + tag + "</error-tag><error-severity>error</error-severity></rpc-error>";
+}
+
+Server::Server(const std::filesystem::path& modulesDir, std::vector<Rule> rules)
+    : m_modulesDir(modulesDir)
+    , m_rules(std::move(rules))
+    , m_answered(m_rules.size(), 0)
+{
+}
+
+Server::~Server()
+{
+    if (m_listenFd) {
+        // This wakes up the blocking accept()
+        ::shutdown(*m_listenFd, SHUT_RDWR);
+        m_acceptor.join();
+        ::close(*m_listenFd);
+        std::filesystem::remove(*m_socketPath);
+    }
+
+    std::vector<std::jthread> threads;
+    {
+        std::unique_lock lock{m_mtx};
+        for (auto fd : m_fds) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        threads = std::move(m_threads);
+    }
+    // Each session closes its own socket
+    threads.clear();
+}
+
+/** @short Starts a new session on a socketpair, and returns the client's end of it
+
+The caller owns the returned file descriptor. It can be used as both the source and the sink of Session::connectFd().
+*/
+int Server::connect()
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1) {
+        throw std::system_error{errno, std::system_category(), "socketpair"};
+    }
+    start(fds[0]);
+    return fds[1];
+}
+
+/** @short Accepts sessions on a Unix socket at @p socketPath, see Session::connectSocket() */
+void Server::listen(const std::filesystem::path& socketPath)
+{
+    if (m_listenFd) {
+        throw std::logic_error{"The mock server is already listening"};
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.native().size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument{"Socket path too long: " + socketPath.native()};
+    }
+    std::copy(socketPath.native().begin(), socketPath.native().end(), addr.sun_path);
+
+    auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        throw std::system_error{errno, std::system_category(), "socket"};
+    }
+    std::filesystem::remove(socketPath);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1 || ::listen(fd, SOMAXCONN) == -1) {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error{err, std::system_category(), "Cannot listen on " + socketPath.native()};
+    }
+    m_listenFd = fd;
+    m_socketPath = socketPath;
+
+    m_acceptor = std::jthread{[this, fd] {
+        while (true) {
+            auto client = ::accept4(fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client == -1) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                return;
+            }
+            start(client);
+        }
+    }};
+}
+
+/** @short How many RPCs the rule at index @p rule has answered so far, in all sessions */
+unsigned Server::answered(const std::size_t rule) const
+{
+    std::unique_lock lock{m_mtx};
+    return m_answered.at(rule);
+}
+
+/** @short The number of sessions which have completed the hello exchange so far */
+unsigned Server::sessions() const
+{
+    std::unique_lock lock{m_mtx};
+    return m_sessions;
+}
+
+void Server::start(const int fd)
+{
+    std::vector<std::jthread> finished;
+    std::unique_lock lock{m_mtx};
+    // Clients connect and disconnect in loops, the threads of sessions which have ended must not pile up
+    for (auto it = m_threads.begin(); it != m_threads.end();) {
+        if (std::erase(m_finished, it->get_id())) {
+            finished.push_back(std::move(*it));
+            it = m_threads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_fds.push_back(fd);
+    m_threads.emplace_back([this, fd] { serve(fd); });
+}
+
+std::string Server::schemaReply(const std::string& identifier, const std::optional<std::string>& version)
+{
+    auto key = identifier + '@' + version.value_or("");
+    {
+        std::unique_lock lock{m_mtx};
+        if (auto it = m_schemas.find(key); it != m_schemas.end()) {
+            return it->second;
+        }
+    }
+
+    auto path = m_modulesDir / (version ? identifier + '@' + *version + ".yang" : identifier + ".yang");
+    if (!version && !std::filesystem::exists(path)) {
+        // Without a revision, the latest one is requested
+        std::vector<std::filesystem::path> candidates;
+        for (const auto& entry : std::filesystem::directory_iterator{m_modulesDir}) {
+            if (entry.path().filename().native().starts_with(identifier + '@')) {
+                candidates.push_back(entry.path());
+            }
+        }
+        if (!candidates.empty()) {
+            path = *std::max_element(candidates.begin(), candidates.end());
+        }
+    }
+
+    std::ifstream ifs{path};
+    if (!ifs.is_open()) {
+        return rpcError("invalid-value");
+    }
+    std::ostringstream ss;
+    ss << ifs.rdbuf();
+    auto reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-monitoring">)" + escapeXMLchars(ss.str()) + "</data>";
+
+    std::unique_lock lock{m_mtx};
+    return m_schemas.emplace(key, std::move(reply)).first->second;
+}
+
+void Server::serve(const int fd)
+{
+    auto closeFd = [this, fd] {
+        std::unique_lock lock{m_mtx};
+        std::erase(m_fds, fd);
+        ::close(fd);
+        m_finished.push_back(std::this_thread::get_id());
+    };
+
+    Connection conn{fd};
+    if (!conn.readHello() || !conn.write(serverHelloMessage())) {
+        closeFd();
+        return;
+    }
+    {
+        std::unique_lock lock{m_mtx};
+        ++m_sessions;
+    }
+
+    while (auto msg = conn.readChunked()) {
+        auto msgId = messageId(*msg);
+        std::string reply;
+        bool close = false;
+
+        if (msg->find("<close-session") != std::string::npos) {
+            reply = "<ok/>";
+            close = true;
+        } else if (msg->find("<get-schema") != std::string::npos) {
+            reply = schemaReply(element(*msg, "identifier").value_or(""), element(*msg, "version"));
+        } else if (msg->find("<get") != std::string::npos && msg->find("ietf-yang-library") != std::string::npos) {
+            reply = yangLibraryData();
+        } else {
+            auto rule = m_rules.end();
+            {
+                std::unique_lock lock{m_mtx};
+                for (auto it = m_rules.begin(); it != m_rules.end(); ++it) {
+                    auto& answered = m_answered[it - m_rules.begin()];
+                    if ((!it->times || answered < *it->times)
+                        && std::all_of(it->match.begin(), it->match.end(), [&msg](const auto& str) { return msg->find(str) != std::string::npos; })) {
+                        ++answered;
+                        rule = it;
+                        break;
+                    }
+                }
+            }
+            if (rule == m_rules.end()) {
+                reply = rpcError("operation-not-supported");
+            } else {
+                std::this_thread::sleep_for(rule->latency);
+                if (rule->notifications) {
+                    auto notification = R"(<notification xmlns="urn:ietf:params:xml:ns:netconf:notification:1.0"><eventTime>2026-01-01T00:00:00Z</eventTime>)"
+                        + rule->notification + "</notification>";
+                    for (unsigned i = 0; i < rule->notifications; ++i) {
+                        if (!conn.writeChunked(notification)) {
+                            break;
+                        }
+                    }
+                }
+                reply = rule->reply;
+            }
+        }
+
+        if (!conn.writeChunked(rpcReply(msgId, reply)) || close) {
+            break;
+        }
+    }
+    closeFd();
+}
+
+/** @short The <interfaces> container of ietf-interfaces with @p count entries, including their statistics */
+std::string syntheticInterfaces(const std::size_t count)
+{
+    std::string res = R"(<interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">)";
+    for (std::size_t i = 0; i < count; ++i) {
+        auto n = std::to_string(i);
+        res += "<interface><name>eth" + n + "</name><description>Synthetic interface " + n + "</description><enabled>true</enabled>"
+            "<statistics><in-octets>" + std::to_string(i * 1000) + "</in-octets><out-octets>" + std::to_string(i * 500) + "</out-octets></statistics>"
+            "</interface>";
+    }
+    res += "</interfaces>";
+    return res;
+}
+
+/** @short The number of entries for syntheticInterfaces() which make up roughly @p bytes of XML */
+std::size_t syntheticInterfacesFor(const std::size_t bytes)
+{
+    static const auto perEntry = (syntheticInterfaces(1000).size() - syntheticInterfaces(0).size()) / 1000;
+    return std::max<std::size_t>(1, bytes / perEntry);
+}
+}
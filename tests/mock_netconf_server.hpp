@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mock_server {
+
+/** @short How to answer an <rpc>
+
+A rule applies when the whole <rpc> contains all of the `match` strings, and it has not answered `times` RPCs yet. The
+reply is delayed by `latency`, and preceded by `notifications` copies of a <notification> which carries `notification`.
+*/
+struct Rule {
+    std::vector<std::string> match;
+    /** The content of the <rpc-reply> */
+    std::string reply;
+    std::chrono::microseconds latency{0};
+    unsigned notifications = 0;
+    std::string notification;
+    std::optional<unsigned> times;
+};
+
+/** @short A NETCONF server for many concurrent sessions which runs in the test process
+
+The hello exchange, <get-schema> (served from `modulesDir`) and the retrieval of the YANG library are handled by the
+server itself, everything else is answered according to the first matching rule. An <rpc> which matches no rule gets an
+operation-not-supported error. Rules cannot be changed once the server has been started.
+*/
+class Server {
+public:
+    Server(const std::filesystem::path& modulesDir, std::vector<Rule> rules);
+    ~Server();
+
+    int connect();
+    void listen(const std::filesystem::path& socketPath);
+    unsigned sessions() const;
+    unsigned answered(const std::size_t rule) const;
+
+private:
+    void serve(const int fd);
+    void start(const int fd);
+    std::string schemaReply(const std::string& identifier, const std::optional<std::string>& version);
+
+    std::filesystem::path m_modulesDir;
+    const std::vector<Rule> m_rules;
+    std::vector<unsigned> m_answered;
+    mutable std::mutex m_mtx;
+    std::vector<int> m_fds;
+    std::vector<std::jthread> m_threads;
+    /** Threads of sessions which have ended, start() joins them */
+    std::vector<std::thread::id> m_finished;
+    std::map<std::string, std::string> m_schemas;
+    std::optional<int> m_listenFd;
+    std::jthread m_acceptor;
+    std::optional<std::filesystem::path> m_socketPath;
+    unsigned m_sessions = 0;
+};
+
+std::string escapeXMLchars(const std::string& input);
+std::string rpcError(const std::string& tag);
+std::string serverHelloMessage();
+std::string yangLibraryData();
+
+std::string syntheticInterfaces(const std::size_t count);
+std::size_t syntheticInterfacesFor(const std::size_t bytes);
+}
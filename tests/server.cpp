@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <atomic>
+#include <doctest/doctest.h>
+#include <fcntl.h>
+#include <future>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include <thread>
+#include <unistd.h>
+#include "test_vars.hpp"
+
+using namespace std::string_literals;
+
+namespace {
+const auto clientHello = R"(<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0"><capabilities>)"
+                         R"(<capability>urn:ietf:params:netconf:base:1.0</capability>)"
+                         R"(<capability>urn:ietf:params:netconf:base:1.1</capability>)"
+                         R"(</capabilities></hello>]]>]]>)"s;
+
+/** @short A NETCONF client which just writes and reads raw messages */
+class RawClient {
+public:
+    RawClient(libnetconf::server::Dispatcher& dispatcher)
+    {
+        int toServer[2], fromServer[2];
+        REQUIRE(::pipe2(toServer, O_CLOEXEC) == 0);
+        REQUIRE(::pipe2(fromServer, O_CLOEXEC) == 0);
+        m_sink = toServer[1];
+        m_source = fromServer[0];
+
+        // The dispatcher closes the server's ends of the pipes once the session is gone
+        auto accepted = std::async(std::launch::async, [&] {
+            return dispatcher.open(toServer[0], fromServer[1], "tester");
+        });
+        writeAll(clientHello);
+        REQUIRE(readUntil("]]>]]>").find("urn:ietf:params:netconf:base:1.1") != std::string::npos);
+        m_session.emplace(accepted.get());
+    }
+
+    ~RawClient()
+    {
+        ::close(m_sink);
+        ::close(m_source);
+    }
+
+    void send(int id, const std::string& content)
+    {
+        auto msg = R"(<rpc xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id=")" + std::to_string(id) + R"(">)" + content + "</rpc>";
+        writeAll("\n#" + std::to_string(msg.size()) + "\n" + msg + "\n##\n");
+    }
+
+    std::string receive()
+    {
+        return readUntil("\n##\n");
+    }
+
+    /** @short Ends the session from the server side, and waits until the server has hung up */
+    void endSession()
+    {
+        m_session.reset();
+        char c;
+        while (::read(m_source, &c, 1) > 0) {
+        }
+    }
+
+private:
+    void writeAll(const std::string& data)
+    {
+        size_t written = 0;
+        while (written < data.size()) {
+            auto ret = ::write(m_sink, data.data() + written, data.size() - written);
+            REQUIRE(ret > 0);
+            written += ret;
+        }
+    }
+
+    std::string readUntil(const std::string& terminator)
+    {
+        std::string res;
+        char c;
+        while (!res.ends_with(terminator)) {
+            REQUIRE(::read(m_source, &c, 1) == 1);
+            res.push_back(c);
+        }
+        return res;
+    }
+
+    int m_sink;
+    int m_source;
+    std::optional<libnetconf::server::Session> m_session;
+};
+}
+
+TEST_CASE("server")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+
+    libnetconf::server::Dispatcher dispatcher{ctx, 2};
+    dispatcher.registerHandler("/example-schema:myRpc", [&ctx](const libyang::DataNode&, const libnetconf::server::SessionInfo& session) {
+        REQUIRE(session.username == "tester");
+        return std::optional{ctx.newPath("/example-schema:myRpc/myOutput", "LOL", libyang::CreationOptions::Output)};
+    });
+
+    RawClient client{dispatcher};
+    REQUIRE(dispatcher.sessionCount() == 1);
+
+    DOCTEST_SUBCASE("registered RPC")
+    {
+        client.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+        auto reply = client.receive();
+        REQUIRE(reply.find(R"(message-id="1")") != std::string::npos);
+        REQUIRE(reply.find("<myOutput") != std::string::npos);
+        REQUIRE(reply.find("LOL") != std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("no handler")
+    {
+        client.send(1, R"(<get-config><source><running/></source></get-config>)");
+        REQUIRE(client.receive().find("operation-not-supported") != std::string::npos);
+    }
+
+    DOCTEST_SUBCASE("registering handlers while one runs")
+    {
+        std::promise<void> started;
+        std::promise<void> mayFinish;
+        dispatcher.registerHandler("/example-schema:myRpc", [&](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+            started.set_value();
+            mayFinish.get_future().wait();
+            return std::optional<libyang::DataNode>{};
+        });
+        client.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+        started.get_future().wait();
+
+        auto registered = std::async(std::launch::async, [&] {
+            dispatcher.registerHandler("/ietf-netconf:get-config", [](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+                return std::optional<libyang::DataNode>{};
+            });
+        });
+        auto status = registered.wait_for(std::chrono::seconds{5});
+        mayFinish.set_value();
+        REQUIRE(status == std::future_status::ready);
+        REQUIRE(client.receive().find("<ok/>") != std::string::npos);
+    }
+
+    client.send(2, "<close-session/>");
+    REQUIRE(client.receive().find("<ok/>") != std::string::npos);
+}
+
+TEST_CASE("server session handle")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+    libnetconf::server::Dispatcher dispatcher{ctx, 1};
+
+    RawClient client{dispatcher};
+    REQUIRE(dispatcher.sessionCount() == 1);
+
+    client.endSession();
+    REQUIRE(dispatcher.sessionCount() == 0);
+}
+
+TEST_CASE("in-process client session")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+
+    libnetconf::server::Dispatcher dispatcher{ctx, 2};
+    dispatcher.registerHandler("/example-schema:myRpc", [&ctx](const libyang::DataNode&, const libnetconf::server::SessionInfo& session) {
+        REQUIRE(session.username == "in-process");
+        return std::optional{ctx.newPath("/example-schema:myRpc/myOutput", "LOL", libyang::CreationOptions::Output)};
+    });
+
+    {
+        // The server does not provide its modules, the client finds them on its own
+        auto session = libnetconf::client::Session::connectInProcess(dispatcher, "in-process",
+                libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd));
+        REQUIRE(dispatcher.sessionCount() == 1);
+        auto output = session->rpc_or_action(R"(<myRpc xmlns="http://example.com"/>)");
+        REQUIRE(output);
+        REQUIRE(output->findPath("myOutput", libyang::InputOutputNodes::Output)->asTerm().valueStr() == "LOL");
+    }
+
+    // The dispatcher closes its end of the socketpair once the session is gone
+    for (int i = 0; i < 100 && dispatcher.sessionCount(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    REQUIRE(dispatcher.sessionCount() == 0);
+}
+
+TEST_CASE("server lanes")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+
+    libnetconf::server::Dispatcher dispatcher{ctx, {{"fast", 1, 0}, {"bulk", 1, 0}}};
+
+    std::promise<void> bulkStarted;
+    std::promise<void> bulkMayFinish;
+    auto bulkMayFinishFuture = bulkMayFinish.get_future().share();
+    dispatcher.registerHandler("/example-schema:myRpc", [&](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+        bulkStarted.set_value();
+        bulkMayFinishFuture.wait();
+        return std::optional<libyang::DataNode>{};
+    }, "bulk");
+    dispatcher.registerHandler("/ietf-netconf:get-config", [](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+        return std::optional<libyang::DataNode>{};
+    }, "fast");
+
+    RawClient slow{dispatcher}, quick{dispatcher}, rejected{dispatcher};
+
+    slow.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+    bulkStarted.get_future().wait();
+
+    // The bulk lane is busy, but that doesn't hold back the fast lane...
+    quick.send(1, R"(<get-config><source><running/></source></get-config>)");
+    REQUIRE(quick.receive().find("<ok/>") != std::string::npos);
+
+    // ...while another bulk request is turned down, because that lane has no queue
+    rejected.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+    REQUIRE(rejected.receive().find("resource-denied") != std::string::npos);
+
+    bulkMayFinish.set_value();
+    REQUIRE(slow.receive().find("<ok/>") != std::string::npos);
+}
+
+TEST_CASE("registering handlers while an RPC waits for its lane")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+
+    libnetconf::server::Dispatcher dispatcher{ctx, {{"bulk", 1, 1}}};
+
+    std::atomic<int> calls = 0;
+    std::promise<void> started;
+    std::promise<void> mayFinish;
+    auto mayFinishFuture = mayFinish.get_future().share();
+    dispatcher.registerHandler("/example-schema:myRpc", [&](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+        if (calls++ == 0) {
+            started.set_value();
+        }
+        mayFinishFuture.wait();
+        return std::optional<libyang::DataNode>{};
+    }, "bulk");
+
+    RawClient running{dispatcher}, queued{dispatcher};
+    running.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+    started.get_future().wait();
+    queued.send(1, R"(<myRpc xmlns="http://example.com"/>)");
+    // Give the second RPC a chance to reach the lane, where it has to wait
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    auto registered = std::async(std::launch::async, [&] {
+        dispatcher.registerHandler("/ietf-netconf:get-config", [](const libyang::DataNode&, const libnetconf::server::SessionInfo&) {
+            return std::optional<libyang::DataNode>{};
+        }, "bulk");
+    });
+    auto status = registered.wait_for(std::chrono::seconds{5});
+    mayFinish.set_value();
+    REQUIRE(status == std::future_status::ready);
+    REQUIRE(running.receive().find("<ok/>") != std::string::npos);
+    REQUIRE(queued.receive().find("<ok/>") != std::string::npos);
+    REQUIRE(calls == 2);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <libnetconf2-cpp/snapshot.hpp>
+#include "UniqueResource.hpp"
+#include "test_vars.hpp"
+
+TEST_CASE("snapshot")
+{
+    auto path = std::filesystem::temp_directory_path() / "libnetconf2-cpp-test-snapshot.lyb";
+    auto removeFile = make_unique_resource([] {}, [path] { std::filesystem::remove(path); });
+
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+    auto data = ctx.newPath("/example-schema:myLeaf", "AHOJ");
+    libnetconf::client::writeSnapshot(data, path);
+    REQUIRE(!std::filesystem::exists(std::filesystem::path{path} += ".tmp"));
+
+    DOCTEST_SUBCASE("same context")
+    {
+        auto loaded = libnetconf::client::readSnapshot(ctx, path);
+        REQUIRE(loaded);
+        REQUIRE(*loaded->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::Siblings) == R"({
+  "example-schema:myLeaf": "AHOJ"
+}
+)");
+    }
+
+    DOCTEST_SUBCASE("equivalent context")
+    {
+        auto other = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+        other.loadModule("example-schema");
+        auto loaded = libnetconf::client::readSnapshot(other, path);
+        REQUIRE(loaded);
+        REQUIRE(loaded->path() == "/example-schema:myLeaf");
+    }
+
+    DOCTEST_SUBCASE("incompatible context")
+    {
+        auto other = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+        other.loadModule("example-schema");
+        other.loadModule("ietf-interfaces");
+        REQUIRE_THROWS_AS(libnetconf::client::readSnapshot(other, path), libnetconf::client::SnapshotMismatch);
+    }
+
+    DOCTEST_SUBCASE("failed write keeps the previous snapshot")
+    {
+        // a directory in place of the destination makes the final rename fail
+        auto dir = std::filesystem::temp_directory_path() / "libnetconf2-cpp-test-snapshot-dir";
+        std::filesystem::create_directories(dir / "nonempty");
+        auto removeDir = make_unique_resource([] {}, [dir] { std::filesystem::remove_all(dir); });
+        REQUIRE_THROWS_AS(libnetconf::client::writeSnapshot(data, dir), std::filesystem::filesystem_error);
+        REQUIRE(!std::filesystem::exists(std::filesystem::path{dir} += ".tmp"));
+        REQUIRE(std::filesystem::is_directory(dir / "nonempty"));
+    }
+}
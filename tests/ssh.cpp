@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include "ssh_server.hpp"
+#include "test_vars.hpp"
+
+namespace {
+auto clientContext()
+{
+    // The dispatcher does not provide its modules, the client finds them on its own
+    return libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+}
+}
+
+TEST_CASE("SSH")
+{
+    auto ctx = libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd);
+    ctx.loadModule("example-schema");
+
+    libnetconf::server::Dispatcher dispatcher{ctx, 2};
+    dispatcher.registerHandler("/example-schema:myRpc", [&ctx](const libyang::DataNode&, const libnetconf::server::SessionInfo& session) {
+        REQUIRE(session.username == "ssh-user");
+        return std::optional{ctx.newPath("/example-schema:myRpc/myOutput", "LOL", libyang::CreationOptions::Output)};
+    });
+
+    ssh_server::SshServer server{dispatcher, "ssh-user", "ssh-password"};
+    libnetconf::client::SshOptions options{
+        .username = "ssh-user",
+        .password = "ssh-password",
+        .knownHosts = libnetconf::SshKnownHosts::Skip,
+    };
+
+    auto callRpc = [](libnetconf::client::Session& session) {
+        auto output = session.rpc_or_action(R"(<myRpc xmlns="http://example.com"/>)");
+        REQUIRE(output);
+        REQUIRE(output->findPath("myOutput", libyang::InputOutputNodes::Output)->asTerm().valueStr() == "LOL");
+    };
+
+    DOCTEST_SUBCASE("two channels on one connection")
+    {
+        auto first = libnetconf::client::Session::connectSsh("127.0.0.1", server.port(), options, clientContext());
+        auto second = first->connectSshChannel(clientContext());
+        REQUIRE(server.connections() == 1);
+        REQUIRE(server.channels() == 2);
+
+        callRpc(*first);
+        callRpc(*second);
+        REQUIRE(dispatcher.sessionCount() == 2);
+
+        // The connection outlives the session which has opened it
+        first.reset();
+        callRpc(*second);
+    }
+
+    DOCTEST_SUBCASE("wrong password")
+    {
+        auto wrong = options;
+        wrong.password = "nope";
+        REQUIRE_THROWS_AS(libnetconf::client::Session::connectSsh("127.0.0.1", server.port(), wrong, clientContext()), std::runtime_error);
+        REQUIRE(server.channels() == 0);
+    }
+}
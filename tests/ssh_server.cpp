@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <arpa/inet.h>
+#include <doctest/doctest.h>
+#include <libssh/callbacks.h>
+#include <libssh/libssh.h>
+#include <libssh/server.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "ssh_server.hpp"
+
+namespace ssh_server {
+
+struct SshServer::Channel {
+    SshServer* server;
+    ssh_channel channel;
+    int fd = -1;
+    ssh_channel_callbacks_struct callbacks{};
+    std::jthread accepting{};
+};
+
+struct SshServer::Callbacks {
+    static int onPassword(ssh_session, const char* user, const char* password, void* userdata)
+    {
+        auto self = static_cast<SshServer*>(userdata);
+        return user == self->m_username && password == self->m_password ? SSH_AUTH_SUCCESS : SSH_AUTH_DENIED;
+    }
+
+    static ssh_channel onChannelOpen(ssh_session session, void* userdata)
+    {
+        auto self = static_cast<SshServer*>(userdata);
+        auto& ch = self->m_openChannels.emplace_back(Channel{.server = self, .channel = ssh_channel_new(session)});
+        ch.callbacks.userdata = &ch;
+        ch.callbacks.channel_subsystem_request_function = onSubsystem;
+        ch.callbacks.channel_data_function = onChannelData;
+        ssh_callbacks_init(&ch.callbacks);
+        ssh_set_channel_callbacks(ch.channel, &ch.callbacks);
+        return ch.channel;
+    }
+
+    static int onSubsystem(ssh_session, ssh_channel, const char* subsystem, void* userdata)
+    {
+        auto ch = static_cast<Channel*>(userdata);
+        if (std::string_view{subsystem} != "netconf") {
+            return SSH_ERROR;
+        }
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds)) {
+            return SSH_ERROR;
+        }
+        ch->fd = fds[0];
+        ssh_event_add_fd(ch->server->m_event, ch->fd, POLLIN, onSocketData, ch);
+        // The hello exchange needs this thread's event loop for relaying, so it cannot block here
+        ch->accepting = std::jthread{[dispatcher = &ch->server->m_dispatcher, fd = fds[1], username = ch->server->m_username] {
+            try {
+                dispatcher->acceptOwnedFd(fd, username);
+            } catch (std::runtime_error&) {
+                // the client has gone away before completing the hello exchange
+            }
+        }};
+        ++ch->server->m_channels;
+        return SSH_OK;
+    }
+
+    static int onChannelData(ssh_session, ssh_channel, void* data, uint32_t len, int, void* userdata)
+    {
+        auto ch = static_cast<Channel*>(userdata);
+        auto ptr = static_cast<const char*>(data);
+        for (uint32_t done = 0; done < len;) {
+            auto written = ::write(ch->fd, ptr + done, len - done);
+            if (written <= 0) {
+                return SSH_ERROR;
+            }
+            done += written;
+        }
+        return len;
+    }
+
+    static int onSocketData(socket_t fd, int, void* userdata)
+    {
+        auto ch = static_cast<Channel*>(userdata);
+        char buf[16384];
+        auto n = ::read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            ssh_channel_write(ch->channel, buf, n);
+        } else {
+            // The dispatcher has dropped the NETCONF session
+            ssh_event_remove_fd(ch->server->m_event, fd);
+            ::close(fd);
+            ch->fd = -1;
+            ssh_channel_send_eof(ch->channel);
+            ssh_channel_close(ch->channel);
+        }
+        return 0;
+    }
+};
+
+/** @short Listens on an ephemeral port of the loopback interface, and serves the first connection which arrives */
+SshServer::SshServer(libnetconf::server::Dispatcher& dispatcher, const std::string& username, const std::string& password)
+    : m_dispatcher(dispatcher)
+    , m_username(username)
+    , m_password(password)
+{
+    m_listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    REQUIRE(m_listener != -1);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(m_listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::listen(m_listener, 1) == 0);
+    socklen_t len = sizeof(addr);
+    REQUIRE(::getsockname(m_listener, reinterpret_cast<sockaddr*>(&addr), &len) == 0);
+    m_port = ntohs(addr.sin_port);
+
+    m_thread = std::jthread{[this](std::stop_token stop) {
+        auto fd = ::accept4(m_listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd != -1) {
+            serve(stop, fd);
+        }
+    }};
+}
+
+/** @short Serves a connection which already exists, e.g., one that a device has opened for NETCONF Call Home */
+SshServer::SshServer(libnetconf::server::Dispatcher& dispatcher, const int connectedFd, const std::string& username, const std::string& password)
+    : m_dispatcher(dispatcher)
+    , m_username(username)
+    , m_password(password)
+{
+    m_thread = std::jthread{[this, connectedFd](std::stop_token stop) { serve(stop, connectedFd); }};
+}
+
+SshServer::~SshServer()
+{
+    m_thread.request_stop();
+    if (m_listener != -1) {
+        ::shutdown(m_listener, SHUT_RDWR);
+    }
+    m_thread.join();
+    if (m_listener != -1) {
+        ::close(m_listener);
+    }
+}
+
+uint16_t SshServer::port() const
+{
+    return m_port;
+}
+
+unsigned SshServer::connections() const
+{
+    return m_connections;
+}
+
+unsigned SshServer::channels() const
+{
+    return m_channels;
+}
+
+void SshServer::serve(std::stop_token stop, int fd)
+{
+    ++m_connections;
+
+    ssh_key hostKey;
+    REQUIRE(ssh_pki_generate(SSH_KEYTYPE_ED25519, 0, &hostKey) == SSH_OK);
+    auto bind = ssh_bind_new();
+    ssh_bind_options_set(bind, SSH_BIND_OPTIONS_IMPORT_KEY, hostKey);
+    // libssh owns the socket from now on
+    auto session = ssh_new();
+    REQUIRE(ssh_bind_accept_fd(bind, session, fd) == SSH_OK);
+
+    ssh_server_callbacks_struct callbacks{};
+    callbacks.userdata = this;
+    callbacks.auth_password_function = Callbacks::onPassword;
+    callbacks.channel_open_request_session_function = Callbacks::onChannelOpen;
+    ssh_callbacks_init(&callbacks);
+    ssh_set_server_callbacks(session, &callbacks);
+    ssh_set_auth_methods(session, SSH_AUTH_METHOD_PASSWORD);
+
+    if (ssh_handle_key_exchange(session) == SSH_OK) {
+        m_event = ssh_event_new();
+        ssh_event_add_session(m_event, session);
+        while (!stop.stop_requested() && ssh_event_dopoll(m_event, 100) != SSH_ERROR) {
+        }
+        for (auto& ch : m_openChannels) {
+            if (ch.fd != -1) {
+                ssh_event_remove_fd(m_event, ch.fd);
+                ::close(ch.fd);
+                ch.fd = -1;
+            }
+        }
+        ssh_event_remove_session(m_event, session);
+        ssh_event_free(m_event);
+    }
+
+    ssh_disconnect(session);
+    ssh_free(session);
+    ssh_bind_free(bind);
+}
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+#pragma once
+
+#include <atomic>
+#include <libnetconf2-cpp/netconf-server.hpp>
+#include <list>
+#include <thread>
+
+struct ssh_event_struct;
+
+namespace ssh_server {
+
+/** @short A minimal SSH server which hands every "netconf" subsystem channel over to a Dispatcher
+
+It serves a single SSH connection and authenticates it with a fixed password. Data are relayed between each channel and
+one end of a socketpair whose other end belongs to the dispatcher.
+*/
+class SshServer {
+public:
+    SshServer(libnetconf::server::Dispatcher& dispatcher, const std::string& username, const std::string& password);
+    SshServer(libnetconf::server::Dispatcher& dispatcher, const int connectedFd, const std::string& username, const std::string& password);
+    ~SshServer();
+
+    uint16_t port() const;
+    unsigned connections() const;
+    unsigned channels() const;
+
+private:
+    struct Channel;
+    struct Callbacks;
+
+    void serve(std::stop_token stop, int fd);
+
+    libnetconf::server::Dispatcher& m_dispatcher;
+    std::string m_username;
+    std::string m_password;
+    int m_listener = -1;
+    uint16_t m_port = 0;
+    std::atomic<unsigned> m_connections = 0;
+    std::atomic<unsigned> m_channels = 0;
+    ssh_event_struct* m_event = nullptr;
+    std::list<Channel> m_openChannels;
+    std::jthread m_thread;
+};
+}
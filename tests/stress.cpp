@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <atomic>
+#include <doctest/doctest.h>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libyang-cpp/Context.hpp>
+#include <thread>
+#include <unistd.h>
+#include "UniqueResource.hpp"
+#include "mock_netconf_server.hpp"
+#include "test_vars.hpp"
+
+/*
+ * Many threads with their own sessions, all of them sharing libnetconf2's global state. Build with
+ * -DCMAKE_CXX_FLAGS=-fsanitize=thread to have ThreadSanitizer check this.
+ */
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr auto latency = 2ms;
+/** How many sessions run at once, each in its own thread */
+constexpr int sessions = 64;
+
+struct Client {
+    explicit Client(mock_server::Server& server)
+        : fd(server.connect())
+        , session(libnetconf::client::Session::connectFd(fd, fd, libyang::Context(TESTS_DIR "/modules", libyang::ContextOptions::DisableSearchCwd)))
+    {
+    }
+
+    ~Client()
+    {
+        session.reset();
+        ::close(fd);
+    }
+
+    int fd;
+    std::unique_ptr<libnetconf::client::Session> session;
+};
+
+void mixedRpcs(libnetconf::client::Session& session)
+{
+    auto data = session.getData(libnetconf::NmdaDatastore::Running);
+    REQUIRE(data);
+    session.editConfig(libnetconf::Datastore::Running, libnetconf::EditDefaultOp::Merge, libnetconf::EditTestOpt::TestSet,
+                       libnetconf::EditErrorOpt::Rollback, R"(<myLeaf xmlns="http://example.com">AHOJ</myLeaf>)");
+    REQUIRE_THROWS_AS(session.discard(), libnetconf::client::ReportedError);
+}
+}
+
+TEST_CASE("stress")
+{
+    mock_server::Server server{TESTS_DIR "/modules", {
+        {
+            .match = {"<get-data"},
+            .reply = R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)",
+            .latency = latency,
+        },
+        {.match = {"<edit-config"}, .reply = "<ok/>", .latency = latency},
+    }};
+
+    DOCTEST_SUBCASE("connect, call and disconnect while log callbacks change")
+    {
+        std::atomic<unsigned> logged{0};
+        auto resetLogging = make_unique_resource([] {}, [] {
+            libnetconf::client::setLogCallback(nullptr);
+            libnetconf::client::setLogLevel(libnetconf::LogLevel::Error);
+        });
+        libnetconf::client::setLogLevel(libnetconf::LogLevel::Debug);
+
+        std::atomic<int> running{sessions};
+        std::jthread toggler{[&logged, &running] {
+            while (running) {
+                libnetconf::client::setLogCallback([&logged](const auto*, auto, const char*) { ++logged; });
+                libnetconf::client::setLogCallback([](const auto*, auto, const char*) {});
+            }
+        }};
+
+        {
+            std::vector<std::jthread> clients;
+            for (int i = 0; i < sessions; ++i) {
+                clients.emplace_back([&server, &running] {
+                    auto done = make_unique_resource([] {}, [&running] { --running; });
+                    for (int j = 0; j < 3; ++j) {
+                        Client client{server};
+                        mixedRpcs(*client.session);
+                    }
+                });
+            }
+        }
+        toggler.join();
+
+        REQUIRE(server.sessions() == sessions * 3);
+        REQUIRE(logged > 0);
+    }
+
+    DOCTEST_SUBCASE("throughput with many sessions")
+    {
+        std::vector<std::unique_ptr<Client>> clients;
+        for (int i = 0; i < sessions; ++i) {
+            clients.emplace_back(std::make_unique<Client>(server));
+        }
+
+        constexpr int rounds = 20;
+        auto run = [&clients](const int count) {
+            auto start = std::chrono::steady_clock::now();
+            {
+                std::vector<std::jthread> workers;
+                for (int i = 0; i < count; ++i) {
+                    workers.emplace_back([session = clients[i]->session.get()] {
+                        for (int j = 0; j < rounds; ++j) {
+                            mixedRpcs(*session);
+                        }
+                    });
+                }
+            }
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return count * rounds / elapsed;
+        };
+
+        auto single = run(1);
+        auto parallel = run(sessions);
+        MESSAGE("RPCs per second with 1 session: " << single << ", with " << sessions << " sessions: " << parallel
+                << " (" << parallel / single << "x)");
+        // The server's latency dominates, so unless the sessions wait for each other, this is nearly linear. The bound
+        // is loose enough for a busy machine, but a lock which serializes the sessions would not get anywhere near it.
+        REQUIRE(parallel > single * sessions / 4);
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+#include <boost/version.hpp>
+#if BOOST_VERSION < 108800
+#include <boost/process.hpp>
+#else
+#define BOOST_PROCESS_VERSION 1
+#include <boost/process/v1/pipe.hpp>
+#endif
+
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <libnetconf2-cpp/netconf-client.hpp>
+#include <libnetconf2-cpp/traffic.hpp>
+#include <thread>
+#include <unistd.h>
+#include "MessageCounter.hpp"
+#include "UniqueResource.hpp"
+#include "mock_server.hpp"
+
+using namespace std::string_literals;
+
+namespace {
+std::string getDataJSON(libnetconf::client::Session& session)
+{
+    auto data = session.getData(libnetconf::NmdaDatastore::Running);
+    REQUIRE(data);
+    return *data->printStr(libyang::DataFormat::JSON, libyang::PrintFlags::Siblings);
+}
+
+auto emptyContext()
+{
+    return libyang::Context(std::nullopt, libyang::ContextOptions::DisableSearchCwd | libyang::ContextOptions::DisableSearchDirs);
+}
+}
+
+TEST_CASE("traffic capture")
+{
+    auto capture = std::filesystem::temp_directory_path() / "libnetconf2-cpp-test-traffic.cap";
+    auto removeFile = make_unique_resource([] {}, [capture] { std::filesystem::remove(capture); });
+    const auto expectedJSON = R"({
+  "example-schema:myLeaf": "AHOJ"
+}
+)"s;
+
+    {
+        boost::process::ipstream processOutput;
+        boost::process::opstream processInput;
+        int curMsgId = 1;
+
+        auto client = std::jthread{[&] {
+            auto session = libnetconf::client::Session::connectFdRecording(processInput.pipe().native_source(), processOutput.pipe().native_sink(), capture, emptyContext());
+            REQUIRE(getDataJSON(*session) == expectedJSON);
+        }};
+
+        mock_server::handleSessionStart(curMsgId, processInput, processOutput);
+        mock_server::skipNetconfChunk(processOutput, {"<get-data"});
+        mock_server::sendRpcReply(curMsgId, processInput, R"(<data xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-nmda"><myLeaf xmlns="http://example.com">AHOJ</myLeaf></data>)");
+        mock_server::skipNetconfChunk(processOutput, {"<close-session"});
+        mock_server::sendRpcReply(curMsgId, processInput, mock_server::OK_REPLY);
+    }
+
+    libnetconf::client::ReplaySpeed speed;
+    DOCTEST_SUBCASE("maximum speed")
+    {
+        speed = libnetconf::client::ReplaySpeed::Maximum;
+    }
+    DOCTEST_SUBCASE("original speed")
+    {
+        speed = libnetconf::client::ReplaySpeed::Original;
+    }
+
+    libnetconf::client::TrafficReplayer replayer{capture, speed};
+    int toServer[2], toClient[2];
+    REQUIRE(::pipe(toServer) == 0);
+    REQUIRE(::pipe(toClient) == 0);
+    auto closePipes = make_unique_resource([] {}, [&] {
+        for (auto fd : {toServer[0], toClient[0], toClient[1]}) {
+            ::close(fd);
+        }
+    });
+
+    auto server = std::jthread{[&] {
+        replayer.serve(toServer[0], toClient[1]);
+    }};
+
+    {
+        auto session = libnetconf::client::Session::connectFd(toClient[0], toServer[1], emptyContext());
+        REQUIRE(getDataJSON(*session) == expectedJSON);
+    }
+    // The replayer returns once the client closes its end
+    ::close(toServer[1]);
+    server.join();
+}
+
+TEST_CASE("message framing")
+{
+    auto chunk = [](const std::string& data) {
+        return "\n#" + std::to_string(data.size()) + "\n" + data;
+    };
+    const auto endOfChunks = "\n##\n"s;
+
+    // A base:1.0 hello, followed by chunked messages whose payload contains both framing markers and fake chunk headers
+    const auto stream = "<hello/>]]>]]>"s
+        + chunk("<rpc>\n##\n</rpc>") + endOfChunks
+        + chunk("<rpc>]") + chunk("]>]]>") + chunk("]]>") + chunk("\n#12\n</rpc>") + endOfChunks
+        + chunk("<rpc/>") + endOfChunks;
+    libnetconf::utils::MessageCounter counter;
+
+    DOCTEST_SUBCASE("all at once")
+    {
+        counter.feed(stream.data(), stream.size());
+    }
+
+    DOCTEST_SUBCASE("byte by byte")
+    {
+        for (size_t i = 0; i < stream.size(); ++i) {
+            counter.feed(stream.data() + i, 1);
+        }
+    }
+
+    REQUIRE(counter.count() == 4);
+
+    DOCTEST_SUBCASE("incomplete message")
+    {
+        auto partial = chunk("<rpc>") + "\n##"s;
+        counter.feed(partial.data(), partial.size());
+        REQUIRE(counter.count() == 4);
+        counter.feed("\n", 1);
+        REQUIRE(counter.count() == 5);
+    }
+}
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2026 CESNET, https://photonics.cesnet.cz/
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/*
+ * Generates C++ types for the data nodes of YANG modules, along with code which fills them from a libyang data tree.
+ *
+ * Usage: netconf2-cpp-bindgen --output FILE [--namespace NS] [--search-dir DIR]... MODULE[@REVISION]...
+ */
+
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <libyang-cpp/Context.hpp>
+#include <libyang-cpp/SchemaNode.hpp>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::set<std::string> reservedNames{
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+    "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+    "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double",
+    "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if",
+    "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+    "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed",
+    "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw",
+    "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+    "wchar_t", "while", "xor", "xor_eq",
+    // Members of the generated structs
+    "schemaPath", "Paths", "materialize"};
+
+std::string identifier(const std::string& yangName)
+{
+    std::string res;
+    for (auto c : yangName) {
+        res += (c == '-' || c == '.') ? '_' : c;
+    }
+    if (reservedNames.contains(res)) {
+        res += '_';
+    }
+    return res;
+}
+
+std::string typeName(const std::string& yangName)
+{
+    std::string res;
+    bool upper = true;
+    for (auto c : yangName) {
+        if (c == '-' || c == '.' || c == '_') {
+            upper = true;
+            continue;
+        }
+        res += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        upper = false;
+    }
+    return res;
+}
+
+/** @short The C++ type of a leaf's value, or std::nullopt for the "empty" type */
+std::optional<std::string> valueType(const libyang::LeafBaseType type)
+{
+    switch (type) {
+    case libyang::LeafBaseType::Int8:
+        return "int8_t";
+    case libyang::LeafBaseType::Int16:
+        return "int16_t";
+    case libyang::LeafBaseType::Int32:
+        return "int32_t";
+    case libyang::LeafBaseType::Int64:
+        return "int64_t";
+    case libyang::LeafBaseType::Uint8:
+        return "uint8_t";
+    case libyang::LeafBaseType::Uint16:
+        return "uint16_t";
+    case libyang::LeafBaseType::Uint32:
+        return "uint32_t";
+    case libyang::LeafBaseType::Uint64:
+        return "uint64_t";
+    case libyang::LeafBaseType::Bool:
+        return "bool";
+    case libyang::LeafBaseType::Dec64:
+        return "double";
+    case libyang::LeafBaseType::Empty:
+        return std::nullopt;
+    default:
+        // Enumerations, identities, unions, leafrefs, bits, binary data, and strings, of course
+        return "std::string";
+    }
+}
+
+class Generator {
+public:
+    explicit Generator(std::ostream& out)
+        : m_out(out)
+    {
+    }
+
+    void module(const libyang::Module& mod)
+    {
+        m_module = mod.name();
+        m_out << "namespace " << identifier(mod.name()) << " {\n";
+        std::vector<libyang::SchemaNode> children;
+        for (const auto& child : mod.childInstantiables()) {
+            children.push_back(child);
+        }
+        structure("Root", std::nullopt, children, 0);
+        m_out << "}\n";
+    }
+
+private:
+    void line(const int depth, const std::string& text)
+    {
+        m_out << std::string(depth * 4, ' ') << text << '\n';
+    }
+
+    static bool isData(const libyang::SchemaNode& node)
+    {
+        switch (node.nodeType()) {
+        case libyang::NodeType::Container:
+        case libyang::NodeType::List:
+        case libyang::NodeType::Leaf:
+        case libyang::NodeType::Leaflist:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    struct ChildNames {
+        std::string member;
+        /** The nested struct of a container or a list */
+        std::string type;
+        /** Another child has the same YANG name, it comes from a different module */
+        bool ambiguous;
+    };
+
+    /** @short Picks a distinct member name, and a distinct type name for containers and lists, for each child of a struct
+
+Different YANG names can map to the same identifier, e.g., "foo-bar", "foo.bar" and "foo_bar", and augments from
+different modules can add nodes with the same name. A child from another module which collides with a sibling gets the
+name of its module as a prefix, and whatever still collides gets a suffix. The names must also differ from the struct
+itself and from what the generator puts in every struct.
+    */
+    std::vector<ChildNames> childNames(const std::string& enclosing, const std::vector<libyang::SchemaNode>& children) const
+    {
+        std::map<std::string, unsigned> identifiers, yangNames;
+        for (const auto& child : children) {
+            ++identifiers[identifier(child.name())];
+            ++yangNames[child.name()];
+        }
+
+        std::set<std::string> used{enclosing, "Paths", "schemaPath", "materialize"};
+        auto unique = [&used](const std::string& candidate) {
+            auto res = candidate;
+            for (unsigned i = 2; used.contains(res); ++i) {
+                res = candidate + '_' + (i == 2 ? "" : std::to_string(i));
+            }
+            used.insert(res);
+            return res;
+        };
+
+        std::vector<ChildNames> res;
+        for (const auto& child : children) {
+            const auto module = child.module().name();
+            const auto foreign = module != m_module && identifiers[identifier(child.name())] > 1;
+            res.push_back({
+                .member = unique(foreign ? identifier(module) + '_' + identifier(child.name()) : identifier(child.name())),
+                .type = {},
+                .ambiguous = yangNames[child.name()] > 1,
+            });
+        }
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (children[i].nodeType() == libyang::NodeType::Container || children[i].nodeType() == libyang::NodeType::List) {
+                const auto module = children[i].module().name();
+                const auto foreign = module != m_module && identifiers[identifier(children[i].name())] > 1;
+                res[i].type = unique(foreign ? typeName(module) + typeName(children[i].name()) : typeName(children[i].name()));
+            }
+        }
+        return res;
+    }
+
+    /** @short Emits a struct for a container, a list, or the top level of a module if @p node is not set */
+    void structure(const std::string& name, const std::optional<libyang::SchemaNode>& node, const std::vector<libyang::SchemaNode>& allChildren, const int depth)
+    {
+        std::vector<libyang::SchemaNode> children;
+        for (const auto& child : allChildren) {
+            if (isData(child)) {
+                children.push_back(child);
+            }
+        }
+        const auto names = childNames(name, children);
+
+        line(depth, "struct " + name + " {");
+        if (node) {
+            line(depth + 1, "static constexpr std::string_view schemaPath = \"" + node->path() + "\";");
+        }
+        line(depth + 1, "struct Paths {");
+        for (size_t i = 0; i < children.size(); ++i) {
+            line(depth + 2, "static constexpr std::string_view " + names[i].member + " = \"" + children[i].path() + "\";");
+        }
+        line(depth + 1, "};");
+        m_out << '\n';
+
+        // Nested types first, then the members
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (!names[i].type.empty()) {
+                std::vector<libyang::SchemaNode> grandchildren;
+                for (const auto& grandchild : children[i].childInstantiables()) {
+                    grandchildren.push_back(grandchild);
+                }
+                structure(names[i].type, children[i], grandchildren, depth + 1);
+                m_out << '\n';
+            }
+        }
+
+        for (size_t i = 0; i < children.size(); ++i) {
+            line(depth + 1, memberType(children[i], names[i].type) + ' ' + names[i].member + ';');
+        }
+        m_out << '\n';
+
+        if (node) {
+            line(depth + 1, "static " + name + " materialize(const libyang::DataNode& node)");
+            line(depth + 1, "{");
+            line(depth + 2, name + " res;");
+            line(depth + 2, "if (auto first = node.child()) {");
+            line(depth + 3, "for (const auto& child : first->siblings()) {");
+        } else {
+            line(depth + 1, "/** @short Fills the structure from a data tree, e.g., the one returned by Session::getData() */");
+            line(depth + 1, "static " + name + " materialize(const std::optional<libyang::DataNode>& tree)");
+            line(depth + 1, "{");
+            line(depth + 2, name + " res;");
+            line(depth + 2, "if (tree) {");
+            line(depth + 3, "for (const auto& child : tree->siblings()) {");
+            line(depth + 4, "if (libnetconf::bindings::moduleName(child) != \"" + m_module + "\") {");
+            line(depth + 5, "continue;");
+            line(depth + 4, "}");
+        }
+        line(depth + 4, "const auto name = libnetconf::bindings::schemaName(child);");
+        bool first = true;
+        for (size_t i = 0; i < children.size(); ++i) {
+            auto condition = "name == \"" + children[i].name() + "\"";
+            if (names[i].ambiguous) {
+                condition += " && libnetconf::bindings::moduleName(child) == \"" + children[i].module().name() + "\"";
+            }
+            line(depth + 4, std::string{first ? "if" : "} else if"} + " (" + condition + ") {");
+            line(depth + 5, assignment(children[i], names[i]));
+            first = false;
+        }
+        if (!first) {
+            line(depth + 4, "}");
+        } else {
+            line(depth + 4, "(void)name;");
+        }
+        line(depth + 3, "}");
+        line(depth + 2, "}");
+        line(depth + 2, "return res;");
+        line(depth + 1, "}");
+        line(depth, "};");
+    }
+
+    static bool isKey(const libyang::SchemaNode& node)
+    {
+        return node.nodeType() == libyang::NodeType::Leaf && node.asLeaf().isKey();
+    }
+
+    std::string memberType(const libyang::SchemaNode& node, const std::string& nestedType) const
+    {
+        switch (node.nodeType()) {
+        case libyang::NodeType::Container:
+            return node.asContainer().isPresence() ? "std::optional<" + nestedType + ">" : nestedType;
+        case libyang::NodeType::List:
+            return "std::vector<" + nestedType + ">";
+        case libyang::NodeType::Leaflist:
+            return "std::vector<" + valueType(node.asLeafList().valueType().base()).value_or("bool") + ">";
+        default: {
+            auto type = valueType(node.asLeaf().valueType().base());
+            if (!type) {
+                return "bool";
+            }
+            return isKey(node) ? *type : "std::optional<" + *type + ">";
+        }
+        }
+    }
+
+    std::string assignment(const libyang::SchemaNode& node, const ChildNames& names) const
+    {
+        const auto member = "res." + names.member;
+        switch (node.nodeType()) {
+        case libyang::NodeType::Container:
+            return member + " = " + names.type + "::materialize(child);";
+        case libyang::NodeType::List:
+            return member + ".push_back(" + names.type + "::materialize(child));";
+        case libyang::NodeType::Leaflist: {
+            auto type = valueType(node.asLeafList().valueType().base());
+            return member + ".push_back(" + (type ? "libnetconf::bindings::leafValue<" + *type + ">(child)" : "true") + ");";
+        }
+        default: {
+            auto type = valueType(node.asLeaf().valueType().base());
+            return member + " = " + (type ? "libnetconf::bindings::leafValue<" + *type + ">(child)" : "true") + ";";
+        }
+        }
+    }
+
+    std::ostream& m_out;
+    std::string m_module;
+};
+
+void usage(const char* argv0)
+{
+    std::cerr << "Usage: " << argv0 << " --output FILE [--namespace NS] [--search-dir DIR]... MODULE[@REVISION]...\n";
+}
+}
+
+int main(int argc, char* argv[])
+{
+    std::optional<std::string> output;
+    std::string ns = "bindings";
+    std::vector<std::string> searchDirs;
+    std::vector<std::string> modules;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--output" || arg == "--namespace" || arg == "--search-dir") && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (arg == "--output") {
+                output = value;
+            } else if (arg == "--namespace") {
+                ns = value;
+            } else {
+                searchDirs.push_back(value);
+            }
+        } else if (arg.starts_with("-")) {
+            usage(argv[0]);
+            return 1;
+        } else {
+            modules.push_back(arg);
+        }
+    }
+    if (!output || modules.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        libyang::Context ctx{std::nullopt, libyang::ContextOptions::DisableSearchCwd};
+        for (const auto& dir : searchDirs) {
+            ctx.setSearchDir(dir);
+        }
+
+        std::ostringstream code;
+        code << "// Generated by netconf2-cpp-bindgen, do not edit\n"
+             << "#pragma once\n\n"
+             << "#include <cstdint>\n"
+             << "#include <libnetconf2-cpp/bindings.hpp>\n"
+             << "#include <optional>\n"
+             << "#include <string>\n"
+             << "#include <string_view>\n"
+             << "#include <vector>\n\n"
+             << "namespace " << ns << " {\n";
+
+        // All modules are loaded first, so that the bindings include the nodes which they augment into each other
+        std::vector<libyang::Module> loaded;
+        for (const auto& spec : modules) {
+            auto at = spec.find('@');
+            auto name = spec.substr(0, at);
+            std::optional<std::string> revision;
+            if (at != std::string::npos) {
+                revision = spec.substr(at + 1);
+            }
+            loaded.push_back(ctx.loadModule(name, revision, {"*"}));
+        }
+        Generator generator{code};
+        for (const auto& mod : loaded) {
+            generator.module(mod);
+        }
+        code << "}\n";
+
+        std::ofstream out{*output};
+        out << code.str();
+        if (!out) {
+            std::cerr << "Cannot write " << *output << "\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}